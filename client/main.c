@@ -52,10 +52,20 @@ void SetColors()
 }
 
 // main game client
-int main()
+// pass --capture <file> to record all the network traffic to a file that can be replayed with tools/replay
+// pass --link <conditions> to play over a simulated bad network, like --link latency=100,jitter=20,loss=0.05
+int main(int argc, char** argv)
 {
     SetColors();
 
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (TextIsEqual(argv[i], "--capture"))
+            StartCapture(argv[i + 1]);
+        else if (TextIsEqual(argv[i], "--link") && !SetLinkConditions(argv[i + 1]))
+            TraceLog(LOG_WARNING, "Could not read link conditions %s", argv[i + 1]);
+    }
+
     // set up raylib
     InitWindow(FieldSizeWidth, FieldSizeHeight, "Client");
     SetTargetFPS(60);
@@ -64,9 +74,9 @@ int main()
     bool connected = false;
     Connect();
 
-    // how fast in pixels per second we can move
+    // how fast in pixels per second we can move, the server won't let us go any faster
     // NOTE : the server should send us all this data in a real game
-    float moveSpeed = 200;
+    float moveSpeed = PlayerMoveSpeed;
 
     while (!WindowShouldClose())
     {
@@ -93,6 +103,10 @@ int main()
             // tell the network game play client that we moved
             // it will update the local simulation and cache the data until the next network tick time
             UpdateLocalPlayer(&movement, GetFrameTime());
+
+            // space tags whoever is closest, the server decides if we really got them
+            if (IsKeyPressed(KEY_SPACE))
+                Tag();
         }
         else if (connected)
         {
@@ -120,12 +134,17 @@ int main()
             DrawText(TextFormat("Player %d", GetLocalPlayerId()), 0, 20, 20, PlayerColors[GetLocalPlayerId()]);
 
             // draw all active players, this includes our local player since the game system is maintaining the local simulation
-            for (int i = 0; i < MAX_PLAYERS; i++)
+            // the server's NPCs come after the players, going backwards draws them first so the players are on top
+            for (int i = GetEntityCount() - 1; i >= 0; i--)
             {
                 Vector2 pos = { 0 };
                 if (GetPlayerPos(i, &pos))
                 {
-                    DrawRectangle((int)pos.x, (int)pos.y, PlayerSize, PlayerSize, PlayerColors[i]);
+                    DrawRectangle((int)pos.x, (int)pos.y, PlayerSize, PlayerSize, i < MAX_PLAYERS ? PlayerColors[i] : DARKGRAY);
+
+                    // someone who was just tagged gets a box around them
+                    if (i == GetTaggedPlayer())
+                        DrawRectangleLines((int)pos.x - 3, (int)pos.y - 3, PlayerSize + 6, PlayerSize + 6, WHITE);
                 }
             }
         }
@@ -29,6 +29,7 @@
 // The network game play interface header.
 // This includes the functions and common data used by both the graphical client and the network/game systems
 // This header is what insulates raylib from windows.h calls in enet (https://github.com/zpl-c/enet)
+// The network game play itself lives in the network core library (netcore), this is the raylib side of it
 #pragma once
 
 #include <stdint.h>
@@ -37,6 +38,12 @@
 // It is ok to include raymath, since raymath doesn't have any conflict with windows.h
 #include "raymath.h"
 
+// the network client and protocol from the network core, these don't include enet or raylib
+#include "netclient.h"
+
+// The default instance API used by the graphical client.
+// These are thin wrappers around a single NetClient that convert to and from raylib vectors
+
 // Connect to the server (localhost by default)
 void Connect();
 
@@ -59,11 +66,19 @@ int GetLocalPlayerId();
 // returns false if the player id is not valid
 bool GetPlayerPos(int id, Vector2* pos);
 
-// constants
-#define MAX_PLAYERS 8
-// how big the screen is for all players
-#define FieldSizeWidth 1280
-#define FieldSizeHeight  800
+// get how many ids GetPlayerPos can be asked about, the players come first and then the server's NPCs
+int GetEntityCount();
+
+// Tag the closest player in range, returns false if nobody was close enough
+bool Tag();
+
+// get the id of the player who was just tagged, or -1
+int GetTaggedPlayer();
+
+// Record all network traffic to a capture file that can be replayed with tools/replay
+// returns false if the file could not be opened
+bool StartCapture(const char* fileName);
 
-// how big a player is
-#define PlayerSize 10
\ No newline at end of file
+// Simulate link conditions (latency, jitter, loss, etc) on the connection made by the next Connect
+// the text is a list like "latency=50,jitter=10,loss=0.02,seed=1", returns false if it could not be read
+bool SetLinkConditions(const char* text);
@@ -146,6 +146,7 @@
     #include <arpa/inet.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <netinet/udp.h>
     #include <netdb.h>
     #include <unistd.h>
     #include <string.h>
@@ -162,6 +163,30 @@
     #define MSG_NOSIGNAL 0
     #endif
 
+    #ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+
+    /* UDP segmentation offload socket options, older libc headers may not have them */
+    #ifndef UDP_SEGMENT
+    #define UDP_SEGMENT 103
+    #endif
+    #ifndef UDP_GRO
+    #define UDP_GRO 104
+    #endif
+
+    /* io_uring is driven with raw system calls, so only the kernel's uapi header is needed, not liburing.
+     * Define ENET_NO_IO_URING to leave it out. */
+    #if !defined(ENET_NO_IO_URING) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <linux/io_uring.h>
+    #define ENET_USE_IO_URING 1
+    #endif
+    #endif
+    #endif
+
     #ifdef MSG_MAXIOVLEN
     #define ENET_BUFFER_MAXIMUM MSG_MAXIOVLEN
     #endif
@@ -192,6 +217,23 @@
     #define ENET_SOCKETSET_CHECK(sockset, socket)  FD_ISSET(socket, &(sockset))
 #endif
 
+/* On x86 the checksums pick PCLMUL folding and SSE4.2 crc32 instructions at runtime, see enet_checksum_features.
+ * Define ENET_NO_CHECKSUM_HARDWARE to only use the portable slice-by-8 tables. */
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && !defined(ENET_NO_CHECKSUM_HARDWARE)
+    #define ENET_USE_CHECKSUM_HARDWARE 1
+    #include <immintrin.h>
+    #ifndef _MSC_VER
+    #include <cpuid.h>
+    #endif
+#endif
+
+/* Lets a function use instructions the rest of the build was not compiled for, MSVC allows that anyway */
+#if defined(__GNUC__) || defined(__clang__)
+#define ENET_TARGET(features) __attribute__ ((target(features)))
+#else
+#define ENET_TARGET(features)
+#endif
+
 #ifdef __GNUC__
 #define ENET_DEPRECATED(func) func __attribute__ ((deprecated))
 #elif defined(_MSC_VER)
@@ -205,6 +247,81 @@
 #define ENET_BUFFER_MAXIMUM (1 + 2 * ENET_PROTOCOL_MAXIMUM_PACKET_COMMANDS)
 #endif
 
+/** Number of datagrams a host pulls off its socket per receive call. Each slot owns a full
+ *  ENET_PROTOCOL_MAXIMUM_MTU buffer, so a host reserves ENET_HOST_RECEIVE_BATCH * 4KB for receiving. */
+#ifndef ENET_HOST_RECEIVE_BATCH
+#define ENET_HOST_RECEIVE_BATCH 32
+#endif
+
+/** With receive coalescing (ENET_HOST_OFFLOAD_COALESCE) the kernel can hand over up to 64KB of datagrams
+ *  from one sender at once, so the receive ring switches to ENET_HOST_COALESCED_RECEIVE_BATCH buffers of
+ *  ENET_HOST_COALESCED_RECEIVE_SIZE bytes each. */
+#ifndef ENET_HOST_COALESCED_RECEIVE_BATCH
+#define ENET_HOST_COALESCED_RECEIVE_BATCH 8
+#endif
+
+#define ENET_HOST_COALESCED_RECEIVE_SIZE 65536
+
+/** Limits for one segmentation offload send: the kernel accepts at most 64 segments, the whole run
+ *  has to fit in a single IP datagram, and the run's buffers are gathered into one iovec array. */
+#define ENET_SOCKET_SEGMENTS_MAXIMUM     64
+#define ENET_SOCKET_SEGMENT_DATA_MAXIMUM 65000
+#define ENET_SOCKET_SEGMENT_BUFFERS_MAXIMUM 256
+
+/** Free receive buffers and packet headers a host keeps for reuse when it delivers packets without copying
+ *  (enet_host_zero_copy), on top of the buffers of its receive ring. Anything freed past these is released. */
+#ifndef ENET_HOST_RECEIVE_POOL_BUFFERS
+#define ENET_HOST_RECEIVE_POOL_BUFFERS 32
+#endif
+
+#ifndef ENET_HOST_RECEIVE_POOL_VIEWS
+#define ENET_HOST_RECEIVE_POOL_VIEWS 256
+#endif
+
+/** Fragmented packets are reassembled in pooled buffers of ENET_HOST_REASSEMBLY_CLASSES power of two sizes,
+ *  from ENET_HOST_REASSEMBLY_MINIMUM_SIZE up. Each size keeps up to ENET_HOST_REASSEMBLY_POOL_BYTES of free
+ *  buffers, and at least one. Packets too large for the biggest size are allocated on their own. */
+#define ENET_HOST_REASSEMBLY_CLASSES      14
+#define ENET_HOST_REASSEMBLY_MINIMUM_SIZE 4096
+
+#ifndef ENET_HOST_REASSEMBLY_POOL_BYTES
+#define ENET_HOST_REASSEMBLY_POOL_BYTES (256 * 1024)
+#endif
+
+/** Number of outgoing datagrams a host stages before handing them to the socket in one call. */
+#ifndef ENET_HOST_SEND_BATCH
+#define ENET_HOST_SEND_BATCH 32
+#endif
+
+/* recvmmsg and sendmmsg are only declared by glibc/musl when _GNU_SOURCE is defined before the first
+ * system header. Define ENET_NO_RECVMMSG or ENET_NO_SENDMMSG to force one datagram per syscall. */
+#if defined(__linux__) && defined(_GNU_SOURCE) && !defined(ENET_NO_RECVMMSG)
+#define ENET_USE_RECVMMSG 1
+#endif
+
+#if defined(__linux__) && defined(_GNU_SOURCE) && !defined(ENET_NO_SENDMMSG)
+#define ENET_USE_SENDMMSG 1
+#endif
+
+/* Host groups wait with epoll and wake with an eventfd on Linux, and fall back to select and a
+ * loopback socket elsewhere. Define ENET_NO_EPOLL to use the fallback on Linux too. */
+#if defined(__linux__) && !defined(ENET_NO_EPOLL)
+#define ENET_USE_EPOLL 1
+#endif
+
+/** Most events enet_host_group_wait takes from epoll in one call. */
+#define ENET_HOST_GROUP_WAIT_EVENTS 64
+
+/** Shape of the per host timer wheel that schedules retransmissions, pings and timeouts: 256 one
+ *  millisecond slots, then two levels of 64 slots each covering 256 and 16384 milliseconds, about
+ *  17 minutes in all. Timers further out wait in the last level and are placed again as it turns. */
+#define ENET_TIMER_WHEEL_BITS  8
+#define ENET_TIMER_WHEEL_SLOTS (1 << ENET_TIMER_WHEEL_BITS)
+#define ENET_TIMER_LEVEL_BITS  6
+#define ENET_TIMER_LEVEL_SLOTS (1 << ENET_TIMER_LEVEL_BITS)
+#define ENET_TIMER_LEVELS      2
+#define ENET_TIMER_SPAN        (1u << (ENET_TIMER_WHEEL_BITS + ENET_TIMER_LEVELS * ENET_TIMER_LEVEL_BITS))
+
 #define ENET_UNUSED(x) (void)x;
 
 #define ENET_MAX(x, y) ((x) > (y) ? (x) : (y))
@@ -319,7 +436,8 @@ extern "C" {
         ENET_PROTOCOL_COMMAND_BANDWIDTH_LIMIT          = 10,
         ENET_PROTOCOL_COMMAND_THROTTLE_CONFIGURE       = 11,
         ENET_PROTOCOL_COMMAND_SEND_UNRELIABLE_FRAGMENT = 12,
-        ENET_PROTOCOL_COMMAND_COUNT                    = 13,
+        ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD     = 13,
+        ENET_PROTOCOL_COMMAND_COUNT                    = 14,
 
         ENET_PROTOCOL_COMMAND_MASK                     = 0x0F
     } ENetProtocolCommand;
@@ -328,6 +446,10 @@ extern "C" {
         ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE = (1 << 7),
         ENET_PROTOCOL_COMMAND_FLAG_UNSEQUENCED = (1 << 6),
 
+        /** Set on CONNECT and VERIFY_CONNECT by hosts that understand ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD.
+         *  Older hosts mask it off with the command number, so they keep getting one ACKNOWLEDGE per command. */
+        ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE_BITFIELD = (1 << 5),
+
         ENET_PROTOCOL_HEADER_FLAG_COMPRESSED   = (1 << 14),
         ENET_PROTOCOL_HEADER_FLAG_SENT_TIME    = (1 << 15),
         ENET_PROTOCOL_HEADER_FLAG_MASK         = ENET_PROTOCOL_HEADER_FLAG_COMPRESSED | ENET_PROTOCOL_HEADER_FLAG_SENT_TIME,
@@ -362,6 +484,16 @@ extern "C" {
         enet_uint16               receivedSentTime;
     } ENET_PACKED ENetProtocolAcknowledge;
 
+    /** Acknowledges receivedReliableSequenceNumber like ENetProtocolAcknowledge, plus every sequence number
+     *  base + 1 + n on the same channel for which bit n of receivedBitfield is set. All of them were
+     *  received in the datagram stamped with receivedSentTime. */
+    typedef struct _ENetProtocolAcknowledgeBitfield {
+        ENetProtocolCommandHeader header;
+        enet_uint16               receivedReliableSequenceNumber;
+        enet_uint16               receivedSentTime;
+        enet_uint32               receivedBitfield;
+    } ENET_PACKED ENetProtocolAcknowledgeBitfield;
+
     typedef struct _ENetProtocolConnect {
         ENetProtocolCommandHeader header;
         enet_uint16               outgoingPeerID;
@@ -457,6 +589,7 @@ extern "C" {
         ENetProtocolSendFragment      sendFragment;
         ENetProtocolBandwidthLimit    bandwidthLimit;
         ENetProtocolThrottleConfigure throttleConfigure;
+        ENetProtocolAcknowledgeBitfield acknowledgeBitfield;
     } ENET_PACKED ENetProtocol;
 
     #ifdef _MSC_VER
@@ -478,7 +611,8 @@ extern "C" {
         ENET_SOCKET_WAIT_NONE      = 0,
         ENET_SOCKET_WAIT_SEND      = (1 << 0),
         ENET_SOCKET_WAIT_RECEIVE   = (1 << 1),
-        ENET_SOCKET_WAIT_INTERRUPT = (1 << 2)
+        ENET_SOCKET_WAIT_INTERRUPT = (1 << 2),
+        ENET_SOCKET_WAIT_WAKE      = (1 << 3)  /**< the wait was ended by enet_host_group_wake */
     } ENetSocketWait;
 
     typedef enum _ENetSocketOption {
@@ -492,6 +626,8 @@ extern "C" {
         ENET_SOCKOPT_ERROR     = 8,
         ENET_SOCKOPT_NODELAY   = 9,
         ENET_SOCKOPT_IPV6_V6ONLY = 10,
+        ENET_SOCKOPT_UDP_SEGMENT = 11, /**< Linux only, default segment size for segmentation offload, 0 to only use it per message */
+        ENET_SOCKOPT_UDP_GRO     = 12, /**< Linux only, let the kernel coalesce received datagrams */
     } ENetSocketOption;
 
     typedef enum _ENetSocketShutdown {
@@ -533,6 +669,7 @@ extern "C" {
         ENET_PACKET_FLAG_NO_ALLOCATE         = (1 << 2), /** packet will not allocate data, and user must supply it instead */
         ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT = (1 << 3), /** packet will be fragmented using unreliable (instead of reliable) sends if it exceeds the MTU */
         ENET_PACKET_FLAG_SENT                = (1 << 8), /** whether the packet has been sent from all queues it has been entered into */
+        ENET_PACKET_FLAG_RECEIVE_VIEW        = (1 << 9), /** packet data points into the receive buffer it arrived in, which stays in use until the packet is destroyed */
     } ENetPacketFlag;
 
     typedef void (ENET_CALLBACK *ENetPacketFreeCallback)(void *);
@@ -551,6 +688,7 @@ extern "C" {
      *    ENET_PACKET_FLAG_NO_ALLOCATE - packet will not allocate data, and user must supply it instead
      *    ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT - packet will be fragmented using unreliable (instead of reliable) sends if it exceeds the MTU
      *    ENET_PACKET_FLAG_SENT - whether the packet has been sent from all queues it has been entered into
+     *    ENET_PACKET_FLAG_RECEIVE_VIEW - packet data points into the receive buffer it arrived in, see enet_host_zero_copy
      * @sa ENetPacketFlag
      */
     typedef struct _ENetPacket {
@@ -562,6 +700,35 @@ extern "C" {
         void *                 userData;       /**< application private data, may be freely modified */
     } ENetPacket;
 
+    /** A receive buffer shared by the packets delivered straight out of it, see enet_host_zero_copy.
+     *  The data follows the structure in the same allocation. */
+    typedef struct _ENetReceiveBuffer {
+        struct _ENetReceiveBuffer * next;           /**< next free buffer of the pool */
+        struct _ENetReceivePool *   pool;
+        size_t                      referenceCount; /**< one while the host receives into the buffer, plus one per packet pointing into it */
+        enet_uint8 *                data;
+    } ENetReceiveBuffer;
+
+    /** A packet delivered out of a receive buffer, recycled by enet_packet_destroy. */
+    typedef struct _ENetReceiveView {
+        ENetPacket                packet;
+        ENetReceiveBuffer *       buffer;
+        struct _ENetReceiveView * next;             /**< next free view of the pool */
+    } ENetReceiveView;
+
+    /** Receive buffers of one size and the free ones kept for reuse. Packets can outlive the host they
+     *  arrived on, so the pool is only freed once the host has let go and the last buffer is released. */
+    typedef struct _ENetReceivePool {
+        ENetReceiveBuffer * freeBuffers;
+        size_t              freeBufferCount;
+        ENetReceiveView *   freeViews;
+        size_t              freeViewCount;
+        size_t              freeBufferLimit;        /**< free buffers kept for reuse, more are released */
+        size_t              bufferSize;
+        size_t              referenceCount;         /**< one while a host uses the pool, plus one per buffer in use */
+        int                 attached;               /**< the host still uses the pool, released buffers and views go back on the free lists */
+    } ENetReceivePool;
+
     typedef struct _ENetAcknowledgement {
         ENetListNode acknowledgementList;
         enet_uint32  sentTime;
@@ -573,6 +740,7 @@ extern "C" {
         enet_uint16  reliableSequenceNumber;
         enet_uint16  unreliableSequenceNumber;
         enet_uint32  sentTime;
+        enet_uint32  sentTimeMicroseconds; /**< low 32 bits of the host's microsecond clock at the last send, with ENET_HOST_CLOCK_MICROSECONDS */
         enet_uint32  roundTripTimeout;
         enet_uint32  roundTripTimeoutLimit;
         enet_uint32  fragmentOffset;
@@ -591,8 +759,12 @@ extern "C" {
         enet_uint32  fragmentsRemaining;
         enet_uint32 *fragments;
         ENetPacket * packet;
+        ENetListNode fragmentList; /**< in the peer's fragmentBuckets while the command reassembles a fragmented packet */
     } ENetIncomingCommand;
 
+    /** The incoming command owning a node of a peer's fragment buckets. */
+    #define enet_list_fragments(iterator) ((ENetIncomingCommand *) ((enet_uint8 *) (iterator) - offsetof(ENetIncomingCommand, fragmentList)))
+
     typedef enum _ENetPeerState {
         ENET_PEER_STATE_DISCONNECTED             = 0,
         ENET_PEER_STATE_CONNECTING               = 1,
@@ -633,7 +805,12 @@ extern "C" {
         ENET_PEER_FREE_UNSEQUENCED_WINDOWS     = 32,
         ENET_PEER_RELIABLE_WINDOWS             = 16,
         ENET_PEER_RELIABLE_WINDOW_SIZE         = 0x1000,
-        ENET_PEER_FREE_RELIABLE_WINDOWS        = 8
+        ENET_PEER_FREE_RELIABLE_WINDOWS        = 8,
+        ENET_PEER_FRAGMENT_BUCKETS             = 16,
+        ENET_PEER_DELAY_TARGET                 = 25000, /**< queuing delay, in microseconds, the delay based congestion control aims for by default */
+        ENET_PEER_DELAY_BASE_INTERVAL          = 10000, /**< the lowest round trip time of this many milliseconds, and the ones before, is taken as the delay with empty queues */
+        ENET_PEER_CONGESTION_INITIAL_WINDOW    = 4,     /**< MTUs a peer may have in transit when a congestion control starts with it */
+        ENET_PEER_CONGESTION_MINIMUM_WINDOW    = 2
     };
 
     typedef struct _ENetChannel {
@@ -654,6 +831,11 @@ extern "C" {
      */
     typedef struct _ENetPeer {
         ENetListNode      dispatchList;
+        ENetListNode      freeList;    /**< in host->freePeers while the peer is disconnected */
+        ENetListNode      addressList; /**< in the host->peerAddresses bucket for its address while it is not disconnected */
+        ENetListNode      connectedList; /**< in host->connectedPeerList while connected or waiting to disconnect later */
+        ENetListNode      sendList;      /**< in host->sendQueue while needsSend is set */
+        ENetListNode      timerList;     /**< in a host->timerSlots or host->timerLevels slot while timerScheduled is set */
         struct _ENetHost *host;
         enet_uint16       outgoingPeerID;
         enet_uint16       incomingPeerID;
@@ -701,9 +883,18 @@ extern "C" {
         enet_uint32       highestRoundTripTimeVariance;
         enet_uint32       roundTripTime; /**< mean round trip time (RTT), in milliseconds, between sending a reliable packet and receiving its acknowledgement */
         enet_uint32       roundTripTimeVariance;
+        enet_uint32       roundTripTimeMicroseconds;         /**< roundTripTime before rounding, kept with ENET_HOST_CLOCK_MICROSECONDS */
+        enet_uint32       roundTripTimeVarianceMicroseconds;
         enet_uint32       mtu;
         enet_uint32       windowSize;
         enet_uint32       reliableDataInTransit;
+        enet_uint32       congestionWindow;  /**< bytes of reliable data the delay based congestion control lets the peer have in transit */
+        enet_uint32       congestionEpoch;   /**< when the congestion control last halved congestionWindow after a loss */
+        enet_uint32       baseDelay;         /**< lowest round trip time, in microseconds, of the current base delay interval */
+        enet_uint32       lastBaseDelay;     /**< the same for the interval before */
+        enet_uint32       baseDelayEpoch;    /**< when the current base delay interval started */
+        int               pacingCredit;      /**< bytes of reliable data the peer can send before pacing holds it back, with a congestion control */
+        enet_uint32       pacingTime;        /**< when pacingCredit was last topped up */
         enet_uint16       outgoingReliableSequenceNumber;
         ENetList          acknowledgements;
         ENetList          sentReliableCommands;
@@ -711,7 +902,12 @@ extern "C" {
         ENetList          outgoingReliableCommands;
         ENetList          outgoingUnreliableCommands;
         ENetList          dispatchedCommands;
+        ENetList          fragmentBuckets[ENET_PEER_FRAGMENT_BUCKETS]; /**< incoming commands reassembling fragmented packets, hashed by channel and start sequence number */
         int               needsDispatch;
+        int               needsSend;     /**< the peer has acknowledgements or commands to send, or reliable commands waiting on one */
+        int               timerScheduled;
+        enet_uint32       timerDeadline; /**< when the peer next needs a retransmission check or a ping */
+        int               acknowledgeBitfield; /**< the peer negotiated ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD on connect */
         enet_uint16       incomingUnsequencedGroup;
         enet_uint16       outgoingUnsequencedGroup;
         enet_uint32       unsequencedWindow[ENET_PEER_UNSEQUENCED_WINDOW_SIZE / 32];
@@ -719,6 +915,9 @@ extern "C" {
         size_t            totalWaitingData;
     } ENetPeer;
 
+    /** The peer owning a node of one of the host's intrusive peer lists. */
+    #define enet_list_peer(iterator, field) ((ENetPeer *) ((enet_uint8 *) (iterator) - offsetof(ENetPeer, field)))
+
     /** An ENet packet compressor for compressing UDP packets before socket sends or receives. */
     typedef struct _ENetCompressor {
         /** Context data for the compressor. Must be non-NULL. */
@@ -734,12 +933,84 @@ extern "C" {
         void (ENET_CALLBACK * destroy)(void *context);
     } ENetCompressor;
 
+    /** Congestion control deciding how much reliable data each peer of a host may have in transit. Without one,
+     *  ENet's own throttle is used, which scales the window from the bandwidth settings by packetThrottle. */
+    typedef struct _ENetCongestionControl {
+        /** Context data for the congestion control. Must be non-NULL. */
+        void *context;
+
+        /** Sets up the state of a peer when it is reset for a new connection, and of every peer when the congestion control is attached. May be NULL. */
+        void (ENET_CALLBACK * reset)(void *context, ENetPeer *peer);
+
+        /** Called for each acknowledgement with its round trip time sample in microseconds and the bytes of reliable data it took out of transit. */
+        void (ENET_CALLBACK * acknowledge)(void *context, ENetPeer *peer, enet_uint32 roundTripTime, enet_uint32 acknowledgedLength);
+
+        /** Called when reliable commands of a peer time out and are queued to be resent. */
+        void (ENET_CALLBACK * loss)(void *context, ENetPeer *peer);
+
+        /** Returns the bytes of reliable data the peer may have in transit. Sends are also paced to this window per round trip time. */
+        enet_uint32 (ENET_CALLBACK * window)(void *context, ENetPeer *peer);
+
+        /** Destroys the context when the congestion control is replaced or the host is destroyed. May be NULL. */
+        void (ENET_CALLBACK * destroy)(void *context);
+    } ENetCongestionControl;
+
+    /** A send posted with enet_peer_post, waiting for the host's next service to queue it on the peer. */
+    typedef struct _ENetPostedSend {
+        struct _ENetPostedSend *next;
+        ENetPeer *              peer;
+        ENetPacket *            packet;
+        enet_uint8              channelID;
+    } ENetPostedSend;
+
     /** Callback that computes the checksum of the data held in buffers[0:bufferCount-1] */
     typedef enet_uint32 (ENET_CALLBACK * ENetChecksumCallback)(const ENetBuffer *buffers, size_t bufferCount);
 
     /** Callback for intercepting received raw UDP packets. Should return 1 to intercept, 0 to ignore, or -1 to propagate an error. */
     typedef int (ENET_CALLBACK * ENetInterceptCallback)(struct _ENetHost *host, void *event);
 
+    /** Callback for intercepting datagrams about to be sent, held in buffers[0:bufferCount-1] with dataLength bytes in total.
+     *  Should return 1 if it took the datagram, which then counts as sent, 0 to let the host send it, or -1 to propagate an error. */
+    typedef int (ENET_CALLBACK * ENetSendInterceptCallback)(struct _ENetHost *host, const ENetAddress *address, const ENetBuffer *buffers, size_t bufferCount, size_t dataLength);
+
+    /** CPU features the checksums can use, see enet_checksum_features. */
+    typedef enum _ENetChecksumFeature {
+        ENET_CHECKSUM_FEATURE_PCLMUL = (1 << 0), /**< enet_crc32 folds 16 bytes at a time with carry-less multiplies */
+        ENET_CHECKSUM_FEATURE_SSE42  = (1 << 1)  /**< enet_crc32c uses the crc32 instruction, 8 bytes at a time */
+    } ENetChecksumFeature;
+
+    /** Kernel offloads a host can use, see enet_host_offload. */
+    typedef enum _ENetHostOffload {
+        ENET_HOST_OFFLOAD_SEGMENT  = (1 << 0), /**< send runs of equal sized datagrams to one peer as one UDP_SEGMENT (GSO) message */
+        ENET_HOST_OFFLOAD_COALESCE = (1 << 1)  /**< receive coalesced datagrams with UDP_GRO, this needs a larger receive ring */
+    } ENetHostOffload;
+
+    /** How a host moves datagrams between its socket and the kernel, picked with enet_host_create_transport. */
+    typedef enum _ENetHostTransport {
+        ENET_HOST_TRANSPORT_SOCKET = 0, /**< socket system calls, batched with recvmmsg/sendmmsg where available */
+        ENET_HOST_TRANSPORT_URING  = 1  /**< Linux io_uring, receives stay posted and each send batch is one submission */
+    } ENetHostTransport;
+
+    /** How precisely a host measures round trip times, picked with enet_host_clock. */
+    typedef enum _ENetHostClock {
+        ENET_HOST_CLOCK_MILLISECONDS = 0, /**< round trip times and retransmission timeouts in whole milliseconds */
+        ENET_HOST_CLOCK_MICROSECONDS = 1  /**< round trip times estimated in microseconds, timeouts rounded up to the millisecond timer wheel */
+    } ENetHostClock;
+
+    /** An outgoing datagram staged by a host. Each one has its own command and buffer scratch, so
+     *  datagrams for many peers can be built first and then sent together with enet_socket_send_batch.
+     */
+    typedef struct _ENetDatagram {
+        ENetAddress           address;     /**< where the datagram is sent */
+        ENetBuffer            buffers[ENET_BUFFER_MAXIMUM];
+        size_t                bufferCount;
+        int                   sentLength;  /**< set by enet_socket_send_batch, 0 if the socket would have blocked */
+        struct _ENetPeer *    peer;
+        ENetProtocol          commands[ENET_PROTOCOL_MAXIMUM_PACKET_COMMANDS];
+        enet_uint8            headerData[sizeof(ENetProtocolHeader) + sizeof(enet_uint32)];
+        enet_uint8            compressedData[ENET_PROTOCOL_MAXIMUM_MTU];
+    } ENetDatagram;
+
     /** An ENet host for communicating with peers.
      *
      * No fields should be modified unless otherwise stated.
@@ -768,17 +1039,48 @@ extern "C" {
         size_t                peerCount;    /**< number of peers allocated for this host */
         size_t                channelLimit; /**< maximum number of channels allowed for connected peers */
         enet_uint32           serviceTime;
+        enet_uint64           serviceTimeMicroseconds; /**< the microsecond reading serviceTime was taken from, with ENET_HOST_CLOCK_MICROSECONDS */
+        ENetHostClock         clockMode;               /**< see enet_host_clock */
         ENetList              dispatchQueue;
+        ENetList              freePeers;       /**< disconnected peers, the one that has been free longest first */
+        ENetList              connectedPeerList; /**< peers counted in connectedPeers */
+        ENetList              sendQueue;       /**< peers with something to send, the only ones enet_host_service builds datagrams for */
+        ENetList              timerSlots[ENET_TIMER_WHEEL_SLOTS];                       /**< peers with a timer due within 256ms, by millisecond */
+        ENetList              timerLevels[ENET_TIMER_LEVELS][ENET_TIMER_LEVEL_SLOTS];   /**< peers with timers further out, moved down a level as the wheel turns */
+        enet_uint32           timerTime;       /**< the next millisecond the timer wheel will expire */
+        ENetList *            peerAddresses;   /**< peers that are not disconnected, hashed by address host into peerAddressMask + 1 buckets */
+        size_t                peerAddressMask;
         int                   continueSending;
         size_t                packetSize;
         enet_uint16           headerFlags;
-        ENetProtocol          commands[ENET_PROTOCOL_MAXIMUM_PACKET_COMMANDS];
+        ENetProtocol *        commands;       /**< command scratch of the datagram being built, points into sendBatch */
         size_t                commandCount;
-        ENetBuffer            buffers[ENET_BUFFER_MAXIMUM];
+        ENetBuffer *          buffers;        /**< buffer scratch of the datagram being built, points into sendBatch */
         size_t                bufferCount;
+        ENetDatagram *        sendBatch;      /**< ENET_HOST_SEND_BATCH datagrams waiting to be sent */
+        size_t                sendBatchCount; /**< number of datagrams staged in sendBatch */
         ENetChecksumCallback  checksum; /**< callback the user can set to enable packet checksums for this host */
         ENetCompressor        compressor;
+        ENetCongestionControl congestionControl; /**< see enet_host_congestion_control, context is NULL when the built in throttle is used */
+        ENetPostedSend *      postedSends;       /**< sends posted by other threads, newest first, only touched with atomics */
         enet_uint8            packetData[2][ENET_PROTOCOL_MAXIMUM_MTU];
+        enet_uint8 *          receiveBuffers;                            /**< receiveBufferCount buffers of receiveBufferSize bytes each */
+        size_t                receiveBufferCount;
+        size_t                receiveBufferSize;
+        ENetBuffer            receiveBatch[ENET_HOST_RECEIVE_BATCH];     /**< buffers filled by the last batched receive, dataLength holds the received size */
+        ENetAddress           receiveAddresses[ENET_HOST_RECEIVE_BATCH]; /**< source address of each buffer in receiveBatch */
+        size_t                receiveSegmentSizes[ENET_HOST_RECEIVE_BATCH]; /**< size of the datagrams coalesced into each buffer, 0 if it holds just one */
+        size_t                receiveBatchCount;                         /**< number of buffers held in receiveBatch */
+        size_t                receiveBatchIndex;                         /**< buffer in receiveBatch being processed */
+        size_t                receiveBatchOffset;                        /**< offset of the next datagram in that buffer */
+        ENetReceivePool *     receivePool;                               /**< refcounted receive buffers when packets are delivered without copying, otherwise NULL */
+        ENetReceiveBuffer *   receiveSlots[ENET_HOST_RECEIVE_BATCH];     /**< buffers of the receive ring taken from receivePool */
+        ENetReceiveBuffer *   decompressBuffer;                          /**< buffer compressed datagrams are expanded into, from receivePool */
+        ENetReceiveBuffer *   receivedBuffer;                            /**< buffer holding receivedData that packets can point into, or NULL */
+        ENetReceivePool *     reassemblyPools[ENET_HOST_REASSEMBLY_CLASSES]; /**< buffers fragmented packets are reassembled in, by size, created on first use */
+        enet_uint32           offload;                                   /**< ENET_HOST_OFFLOAD_* flags in use, see enet_host_offload */
+        struct _ENetHostGroup * group;                                   /**< group the host was added to, its wake also ends enet_host_service */
+        struct _ENetUring *   uring;                                     /**< io_uring state when the host uses ENET_HOST_TRANSPORT_URING, otherwise NULL */
         ENetAddress           receivedAddress;
         enet_uint8 *          receivedData;
         size_t                receivedDataLength;
@@ -787,6 +1089,8 @@ extern "C" {
         enet_uint32           totalReceivedData;    /**< total data received, user should reset to 0 as needed to prevent overflow */
         enet_uint32           totalReceivedPackets; /**< total UDP packets received, user should reset to 0 as needed to prevent overflow */
         ENetInterceptCallback intercept;            /**< callback the user can set to intercept received raw UDP packets */
+        ENetSendInterceptCallback sendIntercept;    /**< callback the user can set to intercept datagrams before they are sent */
+        void *                interceptContext;     /**< user data for intercept and sendIntercept */
         size_t                connectedPeers;
         size_t                bandwidthLimitedPeers;
         size_t                duplicatePeers;     /**< optional number of allowed peers from duplicate IPs, defaults to ENET_PROTOCOL_MAXIMUM_PEER_ID */
@@ -794,6 +1098,26 @@ extern "C" {
         size_t                maximumWaitingData; /**< the maximum aggregate amount of buffer space a peer may use waiting for packets to be delivered */
     } ENetHost;
 
+    /** A set of hosts that can be waited on together, for servers that shard their peers over several hosts.
+     *
+     *  Any thread can call enet_host_group_wake to end a wait early, whether it is a wait on the whole group
+     *  or an enet_host_service call on one of its hosts. The wake is safe to call from a signal handler.
+     *
+     *  @sa enet_host_group_create()
+     *  @sa enet_host_group_add()
+     *  @sa enet_host_group_wait()
+     *  @sa enet_host_group_wake()
+     */
+    typedef struct _ENetHostGroup {
+        ENetHost **           hosts;
+        size_t                hostCount;
+        size_t                hostCapacity;
+        int                   epoll;       /**< Linux: epoll instance watching the host sockets and wakeEvent */
+        int                   wakeEvent;   /**< Linux: eventfd written by enet_host_group_wake */
+        ENetSocket            wakeSocket;  /**< elsewhere: loopback socket enet_host_group_wake sends a byte to */
+        ENetAddress           wakeAddress;
+    } ENetHostGroup;
+
     /**
      * An ENet event type, as specified in @ref ENetEvent.
      */
@@ -877,6 +1201,9 @@ extern "C" {
     /** Returns the monotonic time in milliseconds. Its initial value is unspecified unless otherwise set. */
     ENET_API enet_uint32 enet_time_get(void);
 
+    /** Returns the same monotonic time as enet_time_get in microseconds, enet_time_get() == enet_time_get_us() / 1000. */
+    ENET_API enet_uint64 enet_time_get_us(void);
+
     /** ENet socket functions */
     ENET_API ENetSocket enet_socket_create(ENetSocketType);
     ENET_API int        enet_socket_bind(ENetSocket, const ENetAddress *);
@@ -885,7 +1212,9 @@ extern "C" {
     ENET_API ENetSocket enet_socket_accept(ENetSocket, ENetAddress *);
     ENET_API int        enet_socket_connect(ENetSocket, const ENetAddress *);
     ENET_API int        enet_socket_send(ENetSocket, const ENetAddress *, const ENetBuffer *, size_t);
+    ENET_API int        enet_socket_send_batch(ENetSocket, ENetDatagram *, size_t, int *);
     ENET_API int        enet_socket_receive(ENetSocket, ENetAddress *, ENetBuffer *, size_t);
+    ENET_API int        enet_socket_receive_batch(ENetSocket, ENetAddress *, ENetBuffer *, size_t, size_t *);
     ENET_API int        enet_socket_wait(ENetSocket, enet_uint32 *, enet_uint64);
     ENET_API int        enet_socket_set_option(ENetSocket, ENetSocketOption, int);
     ENET_API int        enet_socket_get_option(ENetSocket, ENetSocketOption, int *);
@@ -957,11 +1286,13 @@ extern "C" {
     ENET_API enet_uint32 enet_host_get_bytes_received(ENetHost *);
     ENET_API enet_uint32 enet_host_get_received_data(ENetHost *, enet_uint8** data);
     ENET_API enet_uint32 enet_host_get_mtu(ENetHost *);
+    ENET_API ENetHostTransport enet_host_get_transport(ENetHost *);
 
     ENET_API enet_uint32 enet_peer_get_id(ENetPeer *);
     ENET_API enet_uint32 enet_peer_get_ip(ENetPeer *, char * ip, size_t ipLength);
     ENET_API enet_uint16 enet_peer_get_port(ENetPeer *);
     ENET_API enet_uint32 enet_peer_get_rtt(ENetPeer *);
+    ENET_API enet_uint32 enet_peer_get_rtt_us(ENetPeer *);
     ENET_API enet_uint64 enet_peer_get_packets_sent(ENetPeer *);
     ENET_API enet_uint32 enet_peer_get_packets_lost(ENetPeer *);
     ENET_API enet_uint64 enet_peer_get_bytes_sent(ENetPeer *);
@@ -978,8 +1309,11 @@ extern "C" {
 
     ENET_API ENetPacket * enet_packet_create_offset(const void *, size_t, size_t, enet_uint32);
     ENET_API enet_uint32  enet_crc32(const ENetBuffer *, size_t);
+    ENET_API enet_uint32  enet_crc32c(const ENetBuffer *, size_t);
+    ENET_API enet_uint32  enet_checksum_features(enet_uint32);
 
     ENET_API ENetHost * enet_host_create(const ENetAddress *, size_t, size_t, enet_uint32, enet_uint32);
+    ENET_API ENetHost * enet_host_create_transport(const ENetAddress *, size_t, size_t, enet_uint32, enet_uint32, ENetHostTransport);
     ENET_API void       enet_host_destroy(ENetHost *);
     ENET_API ENetPeer * enet_host_connect(ENetHost *, const ENetAddress *, size_t, enet_uint32);
     ENET_API int        enet_host_check_events(ENetHost *, ENetEvent *);
@@ -987,15 +1321,38 @@ extern "C" {
     ENET_API int        enet_host_send_raw(ENetHost *, const ENetAddress *, enet_uint8 *, size_t);
     ENET_API int        enet_host_send_raw_ex(ENetHost *host, const ENetAddress* address, enet_uint8* data, size_t skipBytes, size_t bytesToSend);
     ENET_API void       enet_host_set_intercept(ENetHost *, const ENetInterceptCallback);
+    ENET_API void       enet_host_set_send_intercept(ENetHost *, const ENetSendInterceptCallback);
     ENET_API void       enet_host_flush(ENetHost *);
     ENET_API void       enet_host_broadcast(ENetHost *, enet_uint8, ENetPacket *);    
     ENET_API void       enet_host_compress(ENetHost *, const ENetCompressor *);
+    ENET_API void       enet_host_congestion_control(ENetHost *, const ENetCongestionControl *);
+    ENET_API int        enet_host_congestion_control_delay(ENetHost *, enet_uint32);
+    ENET_API enet_uint32 enet_host_offload(ENetHost *, enet_uint32);
+    ENET_API int        enet_host_zero_copy(ENetHost *, int);
+    ENET_API void       enet_host_clock(ENetHost *, ENetHostClock);
     ENET_API void       enet_host_channel_limit(ENetHost *, size_t);
     ENET_API void       enet_host_bandwidth_limit(ENetHost *, enet_uint32, enet_uint32);
     extern   void       enet_host_bandwidth_throttle(ENetHost *);
+
+    ENET_API ENetHostGroup * enet_host_group_create(void);
+    ENET_API void            enet_host_group_destroy(ENetHostGroup *);
+    ENET_API int             enet_host_group_add(ENetHostGroup *, ENetHost *);
+    ENET_API void            enet_host_group_remove(ENetHostGroup *, ENetHost *);
+    ENET_API int             enet_host_group_wait(ENetHostGroup *, ENetHost **, size_t, enet_uint32);
+    ENET_API void            enet_host_group_wake(ENetHostGroup *);
+
+#ifdef ENET_USE_IO_URING
+    extern int  enet_uring_create(ENetHost *);
+    extern void enet_uring_destroy(ENetHost *);
+    extern int  enet_uring_descriptor(ENetHost *);
+    extern int  enet_uring_pending(ENetHost *);
+    extern int  enet_uring_send_batch(ENetHost *, ENetDatagram *, size_t);
+    extern int  enet_uring_receive_batch(ENetHost *);
+#endif
     extern  enet_uint64 enet_host_random_seed(void);
 
     ENET_API int                 enet_peer_send(ENetPeer *, enet_uint8, ENetPacket *);
+    ENET_API int                 enet_peer_post(ENetPeer *, enet_uint8, ENetPacket *, int);
     ENET_API ENetPacket *        enet_peer_receive(ENetPeer *, enet_uint8 * channelID);
     ENET_API void                enet_peer_ping(ENetPeer *);
     ENET_API void                enet_peer_ping_interval(ENetPeer *, enet_uint32);
@@ -1011,6 +1368,7 @@ extern "C" {
     extern ENetOutgoingCommand * enet_peer_queue_outgoing_command(ENetPeer *, const ENetProtocol *, ENetPacket *, enet_uint32, enet_uint16);
     extern ENetIncomingCommand * enet_peer_queue_incoming_command(ENetPeer *, const ENetProtocol *, const void *, size_t, enet_uint32, enet_uint32);
     extern ENetAcknowledgement * enet_peer_queue_acknowledgement(ENetPeer *, const ENetProtocol *, enet_uint16);
+    extern void                  enet_peer_queue_send(ENetPeer *);
     extern void                  enet_peer_dispatch_incoming_unreliable_commands(ENetPeer *, ENetChannel *);
     extern void                  enet_peer_dispatch_incoming_reliable_commands(ENetPeer *, ENetChannel *);
     extern void                  enet_peer_on_connect(ENetPeer *);
@@ -1380,7 +1738,7 @@ extern "C" {
         }
 
         packet->referenceCount = 0;
-        packet->flags        = flags;
+        packet->flags        = flags & ~ENET_PACKET_FLAG_RECEIVE_VIEW;
         packet->dataLength   = dataLength;
         packet->freeCallback = NULL;
         packet->userData     = NULL;
@@ -1412,7 +1770,7 @@ extern "C" {
         }
 
         packet->referenceCount = 0;
-        packet->flags        = flags;
+        packet->flags        = flags & ~ENET_PACKET_FLAG_RECEIVE_VIEW;
         packet->dataLength   = dataLength + dataOffset;
         packet->freeCallback = NULL;
         packet->userData     = NULL;
@@ -1424,6 +1782,208 @@ extern "C" {
         return enet_packet_create(packet->data, packet->dataLength, packet->flags);
     }
 
+    static ENetReceivePool *enet_receive_pool_create(size_t bufferSize, size_t freeBufferLimit) {
+        ENetReceivePool *pool = (ENetReceivePool *) enet_malloc(sizeof(ENetReceivePool));
+
+        if (pool == NULL) {
+            return NULL;
+        }
+
+        pool->freeBuffers     = NULL;
+        pool->freeBufferCount = 0;
+        pool->freeViews       = NULL;
+        pool->freeViewCount   = 0;
+        pool->freeBufferLimit = freeBufferLimit;
+        pool->bufferSize      = bufferSize;
+        pool->referenceCount  = 1;
+        pool->attached        = 1;
+
+        return pool;
+    }
+
+    /** Drops a reference to the pool, freeing it and everything on its free lists with the last one. */
+    static void enet_receive_pool_release(ENetReceivePool *pool) {
+        if (--pool->referenceCount > 0) {
+            return;
+        }
+
+        while (pool->freeBuffers != NULL) {
+            ENetReceiveBuffer *buffer = pool->freeBuffers;
+            pool->freeBuffers = buffer->next;
+            enet_free(buffer);
+        }
+
+        while (pool->freeViews != NULL) {
+            ENetReceiveView *view = pool->freeViews;
+            pool->freeViews = view->next;
+            enet_free(view);
+        }
+
+        enet_free(pool);
+    }
+
+    /** The host lets go of its pool. Buffers still pinned by packets keep it alive until they are released. */
+    static void enet_receive_pool_detach(ENetReceivePool *pool) {
+        pool->attached = 0;
+        enet_receive_pool_release(pool);
+    }
+
+    /** Takes a buffer from the pool with one reference, reusing a free one when there is one. */
+    static ENetReceiveBuffer *enet_receive_buffer_acquire(ENetReceivePool *pool) {
+        ENetReceiveBuffer *buffer = pool->freeBuffers;
+
+        if (buffer != NULL) {
+            pool->freeBuffers = buffer->next;
+            --pool->freeBufferCount;
+        } else {
+            buffer = (ENetReceiveBuffer *) enet_malloc(sizeof(ENetReceiveBuffer) + pool->bufferSize);
+            if (buffer == NULL) {
+                return NULL;
+            }
+
+            buffer->pool = pool;
+            buffer->data = (enet_uint8 *) (buffer + 1);
+        }
+
+        buffer->next           = NULL;
+        buffer->referenceCount = 1;
+        ++pool->referenceCount;
+
+        return buffer;
+    }
+
+    static void enet_receive_buffer_release(ENetReceiveBuffer *buffer) {
+        ENetReceivePool *pool = buffer->pool;
+
+        if (--buffer->referenceCount > 0) {
+            return;
+        }
+
+        if (pool->attached && pool->freeBufferCount < pool->freeBufferLimit) {
+            buffer->next      = pool->freeBuffers;
+            pool->freeBuffers = buffer;
+            ++pool->freeBufferCount;
+        } else {
+            enet_free(buffer);
+        }
+
+        enet_receive_pool_release(pool);
+    }
+
+    /** Makes a packet whose data points at dataLength bytes inside buffer, which it keeps in use. */
+    static ENetPacket *enet_receive_view_create(ENetReceiveBuffer *buffer, const void *data, size_t dataLength, enet_uint32 flags) {
+        ENetReceivePool *pool = buffer->pool;
+        ENetReceiveView *view = pool->freeViews;
+
+        if (view != NULL) {
+            pool->freeViews = view->next;
+            --pool->freeViewCount;
+        } else {
+            view = (ENetReceiveView *) enet_malloc(sizeof(ENetReceiveView));
+            if (view == NULL) {
+                return NULL;
+            }
+        }
+
+        view->packet.referenceCount = 0;
+        view->packet.flags          = (flags & ~ENET_PACKET_FLAG_NO_ALLOCATE) | ENET_PACKET_FLAG_RECEIVE_VIEW;
+        view->packet.data           = (enet_uint8 *) data;
+        view->packet.dataLength     = dataLength;
+        view->packet.freeCallback   = NULL;
+        view->packet.userData       = NULL;
+        view->buffer                = buffer;
+        view->next                  = NULL;
+
+        ++buffer->referenceCount;
+
+        return &view->packet;
+    }
+
+    static void enet_receive_view_destroy(ENetReceiveView *view) {
+        ENetReceiveBuffer *buffer = view->buffer;
+        ENetReceivePool *pool     = buffer->pool;
+
+        // the view goes back before the buffer is released, which can be what frees a detached pool
+        if (pool->attached && pool->freeViewCount < ENET_HOST_RECEIVE_POOL_VIEWS) {
+            view->next      = pool->freeViews;
+            pool->freeViews = view;
+            ++pool->freeViewCount;
+        } else {
+            enet_free(view);
+        }
+
+        enet_receive_buffer_release(buffer);
+    }
+
+    /** Swaps a buffer the host receives into for a fresh one when packets still point into it. */
+    static int enet_host_renew_receive_buffer(ENetHost *host, ENetReceiveBuffer **buffer) {
+        ENetReceiveBuffer *fresh;
+
+        if ((*buffer)->referenceCount == 1) {
+            return 0;
+        }
+
+        fresh = enet_receive_buffer_acquire(host->receivePool);
+        if (fresh == NULL) {
+            return -1;
+        }
+
+        enet_receive_buffer_release(*buffer);
+        *buffer = fresh;
+
+        return 0;
+    }
+
+    /** Makes the packet a fragmented message of dataLength bytes is reassembled in. It comes from the
+     *  host's pool for its size, with the fragment bitmap in *fragments behind the data, or from
+     *  packet_create with *fragments left NULL when no pool fits. Only hosts that turned on
+     *  enet_host_zero_copy use the pools, since pooled packets must be destroyed on the service thread.
+     */
+    static ENetPacket *enet_host_reassembly_packet(ENetHost *host, size_t dataLength, enet_uint32 flags, enet_uint32 fragmentCount, enet_uint32 **fragments) {
+        size_t fragmentsOffset = (dataLength + 7) & ~(size_t) 7;
+        size_t size            = fragmentsOffset + (fragmentCount + 31) / 32 * sizeof(enet_uint32);
+        size_t sizeClass       = 0;
+        ENetReceiveBuffer *buffer;
+        ENetPacket *packet;
+
+        *fragments = NULL;
+
+        while (sizeClass < ENET_HOST_REASSEMBLY_CLASSES && ((size_t) ENET_HOST_REASSEMBLY_MINIMUM_SIZE << sizeClass) < size) {
+            ++sizeClass;
+        }
+
+        if (host->receivePool == NULL || sizeClass >= ENET_HOST_REASSEMBLY_CLASSES || callbacks.packet_create != enet_packet_create || callbacks.packet_destroy != enet_packet_destroy) {
+            return callbacks.packet_create(NULL, dataLength, flags);
+        }
+
+        if (host->reassemblyPools[sizeClass] == NULL) {
+            size_t bufferSize = (size_t) ENET_HOST_REASSEMBLY_MINIMUM_SIZE << sizeClass;
+
+            host->reassemblyPools[sizeClass] = enet_receive_pool_create(bufferSize,
+                bufferSize < ENET_HOST_REASSEMBLY_POOL_BYTES ? ENET_HOST_REASSEMBLY_POOL_BYTES / bufferSize : 1
+            );
+
+            if (host->reassemblyPools[sizeClass] == NULL) {
+                return NULL;
+            }
+        }
+
+        buffer = enet_receive_buffer_acquire(host->reassemblyPools[sizeClass]);
+        if (buffer == NULL) {
+            return NULL;
+        }
+
+        // the packet holds the buffer's only reference from here on
+        packet = enet_receive_view_create(buffer, buffer->data, dataLength, flags);
+        enet_receive_buffer_release(buffer);
+
+        if (packet != NULL) {
+            *fragments = (enet_uint32 *) (buffer->data + fragmentsOffset);
+        }
+
+        return packet;
+    }
+
     /**
      * Destroys the packet and deallocates its data.
      * @param packet packet to be destroyed
@@ -1437,44 +1997,204 @@ extern "C" {
             (*packet->freeCallback)((void *)packet);
         }
 
+        if (packet->flags & ENET_PACKET_FLAG_RECEIVE_VIEW) {
+            enet_receive_view_destroy((ENetReceiveView *) packet);
+            return;
+        }
+
         enet_free(packet);
     }
 
     static int initializedCRC32 = 0;
-    static enet_uint32 crcTable[256];
+    static enet_uint32 crcTables[8][256];
+    static enet_uint32 crc32cTables[8][256];
+    static enet_uint32 checksumSupported = 0;
+    static enet_uint32 checksumFeatures  = 0;
 
-    static enet_uint32 reflect_crc(int val, int bits) {
-        int result = 0, bit;
+    /** Builds slice-by-8 tables for a reflected CRC polynomial: tables[k][byte] is the CRC of byte followed by k zero bytes. */
+    static void initialize_crc_tables(enet_uint32 tables[8][256], enet_uint32 polynomial) {
+        int byte, slice;
 
-        for (bit = 0; bit < bits; bit++) {
-            if (val & 1) { result |= 1 << (bits - 1 - bit); }
-            val >>= 1;
+        for (byte = 0; byte < 256; ++byte) {
+            enet_uint32 crc = (enet_uint32) byte;
+            int bit;
+
+            for (bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+            }
+
+            tables[0][byte] = crc;
         }
 
-        return result;
+        for (slice = 1; slice < 8; ++slice) {
+            for (byte = 0; byte < 256; ++byte) {
+                tables[slice][byte] = (tables[slice - 1][byte] >> 8) ^ tables[0][tables[slice - 1][byte] & 0xFF];
+            }
+        }
     }
 
     static void initialize_crc32(void) {
-        int byte;
+        initialize_crc_tables(crcTables, 0xEDB88320);   /* CRC-32 (IEEE 802.3), what enet_crc32 always computed */
+        initialize_crc_tables(crc32cTables, 0x82F63B78); /* CRC-32C (Castagnoli) */
 
-        for (byte = 0; byte < 256; ++byte) {
-            enet_uint32 crc = reflect_crc(byte, 8) << 24;
-            int offset;
+    #ifdef ENET_USE_CHECKSUM_HARDWARE
+        {
+            enet_uint32 ecx;
 
-            for (offset = 0; offset < 8; ++offset) {
-                if (crc & 0x80000000) {
-                    crc = (crc << 1) ^ 0x04c11db7;
-                } else {
-                    crc <<= 1;
-                }
+        #ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 1);
+            ecx = (enet_uint32) info[2];
+        #else
+            unsigned int eax, ebx, ecxInfo, edx;
+            ecxInfo = 0;
+            __get_cpuid(1, &eax, &ebx, &ecxInfo, &edx);
+            ecx = ecxInfo;
+        #endif
+
+            // folding also needs SSE4.1 to pull the result out of the vector
+            if ((ecx & (1 << 1)) && (ecx & (1 << 19))) {
+                checksumSupported |= ENET_CHECKSUM_FEATURE_PCLMUL;
             }
 
-            crcTable[byte] = reflect_crc(crc, 32);
+            if (ecx & (1 << 20)) {
+                checksumSupported |= ENET_CHECKSUM_FEATURE_SSE42;
+            }
         }
+    #endif
 
+        checksumFeatures = checksumSupported;
         initializedCRC32 = 1;
     }
 
+    /** Slice-by-8: eight table lookups per 8 bytes instead of a dependent lookup per byte. */
+    static enet_uint32 enet_crc_slice8(enet_uint32 tables[8][256], enet_uint32 crc, const enet_uint8 *data, size_t length) {
+        while (length >= 8) {
+            enet_uint32 low  = crc ^ ((enet_uint32) data[0] | (enet_uint32) data[1] << 8 | (enet_uint32) data[2] << 16 | (enet_uint32) data[3] << 24);
+            enet_uint32 high = (enet_uint32) data[4] | (enet_uint32) data[5] << 8 | (enet_uint32) data[6] << 16 | (enet_uint32) data[7] << 24;
+
+            crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+                  tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+
+            data   += 8;
+            length -= 8;
+        }
+
+        while (length-- > 0) {
+            crc = (crc >> 8) ^ tables[0][(crc ^ *data++) & 0xFF];
+        }
+
+        return crc;
+    }
+
+    #ifdef ENET_USE_CHECKSUM_HARDWARE
+
+    /** CRC-32 by folding with carry-less multiplies, from Intel's "Fast CRC Computation for Generic Polynomials
+     *  Using PCLMULQDQ Instruction". Four 128 bit lanes are folded 64 bytes at a time, then into one lane, which
+     *  is reduced to 32 bits with a Barrett reduction. length has to be at least 64 and a multiple of 16.
+     */
+    ENET_TARGET("pclmul,sse4.1")
+    static enet_uint32 enet_crc32_fold(enet_uint32 crc, const enet_uint8 *data, size_t length) {
+        /* the bit reflected folding constants and Barrett polynomials for 0x04C11DB7 from the paper */
+        static const enet_uint64 foldBy4[2]   = { 0x0154442bd4ULL, 0x01c6e41596ULL };
+        static const enet_uint64 foldBy1[2]   = { 0x01751997d0ULL, 0x00ccaa009eULL };
+        static const enet_uint64 fold64[2]    = { 0x0163cd6124ULL, 0x0000000000ULL };
+        static const enet_uint64 barrett[2]   = { 0x01db710641ULL, 0x01f7011641ULL };
+        __m128i constants, lane0, lane1, lane2, lane3, low, mask;
+
+        lane0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (data + 0x00)), _mm_cvtsi32_si128((int) crc));
+        lane1 = _mm_loadu_si128((const __m128i *) (data + 0x10));
+        lane2 = _mm_loadu_si128((const __m128i *) (data + 0x20));
+        lane3 = _mm_loadu_si128((const __m128i *) (data + 0x30));
+
+        constants = _mm_loadu_si128((const __m128i *) foldBy4);
+        data   += 64;
+        length -= 64;
+
+        while (length >= 64) {
+            lane0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane0, constants, 0x00), _mm_clmulepi64_si128(lane0, constants, 0x11)),
+                                  _mm_loadu_si128((const __m128i *) (data + 0x00)));
+            lane1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane1, constants, 0x00), _mm_clmulepi64_si128(lane1, constants, 0x11)),
+                                  _mm_loadu_si128((const __m128i *) (data + 0x10)));
+            lane2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane2, constants, 0x00), _mm_clmulepi64_si128(lane2, constants, 0x11)),
+                                  _mm_loadu_si128((const __m128i *) (data + 0x20)));
+            lane3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane3, constants, 0x00), _mm_clmulepi64_si128(lane3, constants, 0x11)),
+                                  _mm_loadu_si128((const __m128i *) (data + 0x30)));
+
+            data   += 64;
+            length -= 64;
+        }
+
+        // fold the four lanes into one, then the remaining 16 byte blocks into it
+        constants = _mm_loadu_si128((const __m128i *) foldBy1);
+
+        lane0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane0, constants, 0x00), _mm_clmulepi64_si128(lane0, constants, 0x11)), lane1);
+        lane0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane0, constants, 0x00), _mm_clmulepi64_si128(lane0, constants, 0x11)), lane2);
+        lane0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane0, constants, 0x00), _mm_clmulepi64_si128(lane0, constants, 0x11)), lane3);
+
+        while (length >= 16) {
+            lane0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane0, constants, 0x00), _mm_clmulepi64_si128(lane0, constants, 0x11)),
+                                  _mm_loadu_si128((const __m128i *) data));
+
+            data   += 16;
+            length -= 16;
+        }
+
+        // 128 bits down to 64
+        mask  = _mm_setr_epi32(~0, 0, ~0, 0);
+        low   = _mm_clmulepi64_si128(lane0, constants, 0x10);
+        lane0 = _mm_xor_si128(_mm_srli_si128(lane0, 8), low);
+
+        constants = _mm_loadl_epi64((const __m128i *) fold64);
+        low   = _mm_srli_si128(lane0, 4);
+        lane0 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(lane0, mask), constants, 0x00), low);
+
+        // Barrett reduction to 32 bits
+        constants = _mm_loadu_si128((const __m128i *) barrett);
+        low   = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(lane0, mask), constants, 0x10), mask);
+        lane0 = _mm_xor_si128(lane0, _mm_clmulepi64_si128(low, constants, 0x00));
+
+        return (enet_uint32) _mm_extract_epi32(lane0, 1);
+    }
+
+    /** CRC-32C with the SSE4.2 crc32 instruction. */
+    ENET_TARGET("sse4.2")
+    static enet_uint32 enet_crc32c_hardware(enet_uint32 crc, const enet_uint8 *data, size_t length) {
+    #if defined(__x86_64__) || defined(_M_X64)
+        enet_uint64 crc64 = crc;
+
+        while (length >= 8) {
+            enet_uint64 value;
+            memcpy(&value, data, sizeof(value));
+            crc64   = _mm_crc32_u64(crc64, value);
+            data   += 8;
+            length -= 8;
+        }
+
+        crc = (enet_uint32) crc64;
+    #else
+        while (length >= 4) {
+            enet_uint32 value;
+            memcpy(&value, data, sizeof(value));
+            crc     = _mm_crc32_u32(crc, value);
+            data   += 4;
+            length -= 4;
+        }
+    #endif
+
+        while (length-- > 0) {
+            crc = _mm_crc32_u8(crc, *data++);
+        }
+
+        return crc;
+    }
+
+    #endif /* ENET_USE_CHECKSUM_HARDWARE */
+
+    /** Computes the CRC-32 (IEEE 802.3) of the buffers, the checksum ENet has always used.
+     *  Uses PCLMUL folding for buffers of 64 bytes or more when the CPU has it and slice-by-8 tables otherwise,
+     *  every implementation gives the same result.
+     */
     enet_uint32 enet_crc32(const ENetBuffer *buffers, size_t bufferCount) {
         enet_uint32 crc = 0xFFFFFFFF;
 
@@ -1482,11 +2202,41 @@ extern "C" {
 
         while (bufferCount-- > 0) {
             const enet_uint8 *data = (const enet_uint8 *)buffers->data;
-            const enet_uint8 *dataEnd = &data[buffers->dataLength];
+            size_t length = buffers->dataLength;
+
+        #ifdef ENET_USE_CHECKSUM_HARDWARE
+            if ((checksumFeatures & ENET_CHECKSUM_FEATURE_PCLMUL) && length >= 64) {
+                size_t folded = length & ~(size_t) 15;
 
-            while (data < dataEnd) {
-                crc = (crc >> 8) ^ crcTable[(crc & 0xFF) ^ *data++];
+                crc     = enet_crc32_fold(crc, data, folded);
+                data   += folded;
+                length -= folded;
             }
+        #endif
+
+            crc = enet_crc_slice8(crcTables, crc, data, length);
+            ++buffers;
+        }
+
+        return ENET_HOST_TO_NET_32(~crc);
+    }
+
+    /** Computes the CRC-32C (Castagnoli) of the buffers. It can be used as ENetHost::checksum instead of
+     *  enet_crc32, it is the fastest checksum on CPUs with SSE4.2 and slice-by-8 elsewhere. Both ends of a
+     *  connection have to use the same checksum.
+     */
+    enet_uint32 enet_crc32c(const ENetBuffer *buffers, size_t bufferCount) {
+        enet_uint32 crc = 0xFFFFFFFF;
+
+        if (!initializedCRC32) { initialize_crc32(); }
+
+        while (bufferCount-- > 0) {
+        #ifdef ENET_USE_CHECKSUM_HARDWARE
+            if (checksumFeatures & ENET_CHECKSUM_FEATURE_SSE42) {
+                crc = enet_crc32c_hardware(crc, (const enet_uint8 *) buffers->data, buffers->dataLength);
+            } else
+        #endif
+            crc = enet_crc_slice8(crc32cTables, crc, (const enet_uint8 *) buffers->data, buffers->dataLength);
 
             ++buffers;
         }
@@ -1494,6 +2244,18 @@ extern "C" {
         return ENET_HOST_TO_NET_32(~crc);
     }
 
+    /** Limits the CPU features the checksums use, for benchmarks and tests. Everything the CPU supports is used by default.
+     *  @param features ENET_CHECKSUM_FEATURE_* flags the checksums may use
+     *  @returns the flags in use afterwards, features the CPU does not have stay off
+     *  @remarks This changes every host in the process, don't call it while other threads compute checksums.
+     */
+    enet_uint32 enet_checksum_features(enet_uint32 features) {
+        if (!initializedCRC32) { initialize_crc32(); }
+
+        checksumFeatures = features & checksumSupported;
+        return checksumFeatures;
+    }
+
 // =======================================================================//
 // !
 // ! Protocol
@@ -1513,46 +2275,276 @@ extern "C" {
         sizeof(ENetProtocolSendUnsequenced),
         sizeof(ENetProtocolBandwidthLimit),
         sizeof(ENetProtocolThrottleConfigure),
-        sizeof(ENetProtocolSendFragment)
+        sizeof(ENetProtocolSendFragment),
+        sizeof(ENetProtocolAcknowledgeBitfield)
     };
 
     size_t enet_protocol_command_size(enet_uint8 commandNumber) {
         return commandSizes[commandNumber & ENET_PROTOCOL_COMMAND_MASK];
     }
 
-    static void enet_protocol_change_state(ENetHost *host, ENetPeer *peer, ENetPeerState state) {
-        ENET_UNUSED(host)
+    static ENetList * enet_host_address_bucket(ENetHost *host, const struct in6_addr *address) {
+        enet_uint32 words[4];
+        enet_uint32 hash;
 
-        if (state == ENET_PEER_STATE_CONNECTED || state == ENET_PEER_STATE_DISCONNECT_LATER) {
-            enet_peer_on_connect(peer);
+        memcpy(words, address, sizeof(words));
+        hash = (words[0] * 0x9E3779B1u) ^ (words[1] * 0x85EBCA77u) ^ (words[2] * 0xC2B2AE3Du) ^ (words[3] * 0x27D4EB2Fu);
+        hash ^= hash >> 15;
+
+        return &host->peerAddresses[hash & host->peerAddressMask];
+    }
+
+    /** Takes a peer that has just left the disconnected state off the free list and indexes it by its address. */
+    static void enet_host_claim_peer(ENetHost *host, ENetPeer *peer) {
+        enet_list_remove(&peer->freeList);
+        enet_list_insert(enet_list_end(enet_host_address_bucket(host, &peer->address.host)), &peer->addressList);
+    }
+
+    /** Places a peer's timer in the wheel slot for its deadline. Deadlines that have passed go in the next slot to expire. */
+    static void enet_host_timer_insert(ENetHost *host, ENetPeer *peer) {
+        enet_uint32 deadline = peer->timerDeadline;
+        enet_uint32 delta;
+        ENetList *slot;
+
+        if (ENET_TIME_LESS(deadline, host->timerTime)) {
+            deadline = host->timerTime;
+        }
+
+        delta = deadline - host->timerTime;
+        if (delta >= ENET_TIMER_SPAN) {
+            delta    = ENET_TIMER_SPAN - 1;
+            deadline = host->timerTime + delta;
+        }
+
+        if (delta < ENET_TIMER_WHEEL_SLOTS) {
+            slot = &host->timerSlots[deadline & (ENET_TIMER_WHEEL_SLOTS - 1)];
+        } else if (delta < (1u << (ENET_TIMER_WHEEL_BITS + ENET_TIMER_LEVEL_BITS))) {
+            slot = &host->timerLevels[0][(deadline >> ENET_TIMER_WHEEL_BITS) & (ENET_TIMER_LEVEL_SLOTS - 1)];
         } else {
-            enet_peer_on_disconnect(peer);
+            slot = &host->timerLevels[1][(deadline >> (ENET_TIMER_WHEEL_BITS + ENET_TIMER_LEVEL_BITS)) & (ENET_TIMER_LEVEL_SLOTS - 1)];
         }
 
-        peer->state = state;
+        enet_list_insert(enet_list_end(slot), &peer->timerList);
     }
 
-    static void enet_protocol_dispatch_state(ENetHost *host, ENetPeer *peer, ENetPeerState state) {
-        enet_protocol_change_state(host, peer, state);
-
-        if (!peer->needsDispatch) {
-            enet_list_insert(enet_list_end(&host->dispatchQueue), &peer->dispatchList);
-            peer->needsDispatch = 1;
+    static void enet_peer_unschedule_timer(ENetPeer *peer) {
+        if (peer->timerScheduled) {
+            enet_list_remove(&peer->timerList);
+            peer->timerScheduled = 0;
         }
     }
 
-    static int enet_protocol_dispatch_incoming_commands(ENetHost *host, ENetEvent *event) {
-        while (!enet_list_empty(&host->dispatchQueue)) {
-            ENetPeer *peer = (ENetPeer *) enet_list_remove(enet_list_begin(&host->dispatchQueue));
-            peer->needsDispatch = 0;
+    /** Sets a peer's timer for the earliest it can need a retransmission, a timeout check or a ping.
+     *  A timer that fires early does no harm, the peer is looked at and scheduled again. */
+    static void enet_peer_schedule_timer(ENetPeer *peer) {
+        enet_uint32 now = peer->host->serviceTime;
+        ENetListIterator currentCommand;
 
-            switch (peer->state) {
-                case ENET_PEER_STATE_CONNECTION_PENDING:
-                case ENET_PEER_STATE_CONNECTION_SUCCEEDED:
-                    enet_protocol_change_state(host, peer, ENET_PEER_STATE_CONNECTED);
+        enet_peer_unschedule_timer(peer);
 
-                    event->type = ENET_EVENT_TYPE_CONNECT;
-                    event->peer = peer;
+        if (peer->state == ENET_PEER_STATE_DISCONNECTED || peer->state == ENET_PEER_STATE_ZOMBIE) {
+            return;
+        }
+
+        if (!enet_list_empty(&peer->sentReliableCommands)) {
+            peer->timerDeadline = peer->nextTimeout;
+
+            // nextTimeout follows the oldest command, if that has been dealt with find the command that really is next
+            if (ENET_TIME_LESS_EQUAL(peer->timerDeadline, now)) {
+                currentCommand = enet_list_begin(&peer->sentReliableCommands);
+                peer->timerDeadline = ((ENetOutgoingCommand *) currentCommand)->sentTime + ((ENetOutgoingCommand *) currentCommand)->roundTripTimeout;
+
+                for (; currentCommand != enet_list_end(&peer->sentReliableCommands); currentCommand = enet_list_next(currentCommand)) {
+                    ENetOutgoingCommand *outgoingCommand = (ENetOutgoingCommand *) currentCommand;
+
+                    if (ENET_TIME_LESS(outgoingCommand->sentTime + outgoingCommand->roundTripTimeout, peer->timerDeadline)) {
+                        peer->timerDeadline = outgoingCommand->sentTime + outgoingCommand->roundTripTimeout;
+                    }
+                }
+
+                // expired but not checked yet (enet_host_flush doesn't check timeouts), look again on the next service
+                if (ENET_TIME_LESS_EQUAL(peer->timerDeadline, now)) {
+                    peer->timerDeadline = now + 1;
+                }
+            }
+        } else {
+            peer->timerDeadline = peer->lastReceiveTime + peer->pingInterval;
+
+            // a ping that was due but not sent (only connected peers are pinged) is tried again an interval later
+            if (ENET_TIME_LESS_EQUAL(peer->timerDeadline, now)) {
+                peer->timerDeadline = now + peer->pingInterval;
+            }
+        }
+
+        // reliable commands held back by pacing can go once the credit has been topped up
+        if (peer->host->congestionControl.context != NULL && peer->pacingCredit <= 0 &&
+            !enet_list_empty(&peer->outgoingReliableCommands) && ENET_TIME_LESS(now + 1, peer->timerDeadline)
+        ) {
+            peer->timerDeadline = now + 1;
+        }
+
+        enet_host_timer_insert(peer->host, peer);
+        peer->timerScheduled = 1;
+    }
+
+    /** Places the timers in a slot again, relative to the current wheel time. */
+    static void enet_host_timer_cascade(ENetHost *host, ENetList *slot) {
+        ENetList pending;
+
+        // timers can land back in the same slot, so take them all out first
+        enet_list_clear(&pending);
+        while (!enet_list_empty(slot)) {
+            enet_list_insert(enet_list_end(&pending), enet_list_remove(enet_list_begin(slot)));
+        }
+
+        while (!enet_list_empty(&pending)) {
+            enet_host_timer_insert(host, enet_list_peer(enet_list_remove(enet_list_begin(&pending)), timerList));
+        }
+    }
+
+    /** Turns the timer wheel up to now and puts every peer whose timer expired on the send queue. */
+    static void enet_host_expire_timers(ENetHost *host, enet_uint32 now) {
+        ENetList *slot;
+        ENetPeer *peer;
+        size_t i, j;
+
+        // after a long stall, jump the wheel to now and place every timer again rather than turning through every millisecond
+        if (ENET_TIME_GREATER_EQUAL(now, host->timerTime) && now - host->timerTime >= ENET_TIMER_SPAN) {
+            host->timerTime = now;
+
+            for (i = 0; i < ENET_TIMER_WHEEL_SLOTS; ++i) {
+                enet_host_timer_cascade(host, &host->timerSlots[i]);
+            }
+
+            for (i = 0; i < ENET_TIMER_LEVELS; ++i) {
+                for (j = 0; j < ENET_TIMER_LEVEL_SLOTS; ++j) {
+                    enet_host_timer_cascade(host, &host->timerLevels[i][j]);
+                }
+            }
+        }
+
+        while (ENET_TIME_LESS_EQUAL(host->timerTime, now)) {
+            // at the start of each turn, bring down the timers that now fall within reach of the level below
+            if ((host->timerTime & (ENET_TIMER_WHEEL_SLOTS - 1)) == 0) {
+                if ((host->timerTime & ((1u << (ENET_TIMER_WHEEL_BITS + ENET_TIMER_LEVEL_BITS)) - 1)) == 0) {
+                    enet_host_timer_cascade(host, &host->timerLevels[1][(host->timerTime >> (ENET_TIMER_WHEEL_BITS + ENET_TIMER_LEVEL_BITS)) & (ENET_TIMER_LEVEL_SLOTS - 1)]);
+                }
+
+                enet_host_timer_cascade(host, &host->timerLevels[0][(host->timerTime >> ENET_TIMER_WHEEL_BITS) & (ENET_TIMER_LEVEL_SLOTS - 1)]);
+            }
+
+            slot = &host->timerSlots[host->timerTime & (ENET_TIMER_WHEEL_SLOTS - 1)];
+            while (!enet_list_empty(slot)) {
+                peer = enet_list_peer(enet_list_remove(enet_list_begin(slot)), timerList);
+                peer->timerScheduled = 0;
+                enet_peer_queue_send(peer);
+            }
+
+            ++host->timerTime;
+        }
+    }
+
+    /** The earliest deadline in a slot of one of the outer levels. */
+    static int enet_host_timer_slot_deadline(ENetList *slot, enet_uint32 *deadline) {
+        ENetListIterator currentNode;
+        int found = 0;
+
+        for (currentNode = enet_list_begin(slot); currentNode != enet_list_end(slot); currentNode = enet_list_next(currentNode)) {
+            ENetPeer *peer = enet_list_peer(currentNode, timerList);
+
+            if (!found || ENET_TIME_LESS(peer->timerDeadline, *deadline)) {
+                *deadline = peer->timerDeadline;
+                found     = 1;
+            }
+        }
+
+        return found;
+    }
+
+    /** Finds when the next timer on the host expires.
+     *  @returns 1 with the time in deadline, or 0 if no timer is scheduled
+     */
+    static int enet_host_next_timer(ENetHost *host, enet_uint32 *deadline) {
+        enet_uint32 candidate = 0;
+        int found = 0;
+        size_t i, level;
+
+        for (i = 0; i < ENET_TIMER_WHEEL_SLOTS; ++i) {
+            if (!enet_list_empty(&host->timerSlots[(host->timerTime + i) & (ENET_TIMER_WHEEL_SLOTS - 1)])) {
+                *deadline = host->timerTime + (enet_uint32) i;
+                found     = 1;
+                break;
+            }
+        }
+
+        // the first occupied slot of each outer level holds its earliest timers, they can still come before the ones found above
+        // the slot for the current turn holds either timers about to be brought down or ones a whole level away, so it is always checked
+        for (level = 0; level < ENET_TIMER_LEVELS; ++level) {
+            enet_uint32 shift = ENET_TIMER_WHEEL_BITS + (enet_uint32) level * ENET_TIMER_LEVEL_BITS;
+
+            for (i = 0; i < ENET_TIMER_LEVEL_SLOTS; ++i) {
+                ENetList *slot = &host->timerLevels[level][((host->timerTime >> shift) + i) & (ENET_TIMER_LEVEL_SLOTS - 1)];
+
+                if (enet_host_timer_slot_deadline(slot, &candidate)) {
+                    if (!found || ENET_TIME_LESS(candidate, *deadline)) {
+                        *deadline = candidate;
+                        found     = 1;
+                    }
+
+                    if (i > 0) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        // deadlines that had passed when they were placed sit in the next slot
+        if (found && ENET_TIME_LESS(*deadline, host->timerTime)) {
+            *deadline = host->timerTime;
+        }
+
+        return found;
+    }
+
+    /** Puts a peer that has just become disconnected back on the free list. */
+    static void enet_host_release_peer(ENetHost *host, ENetPeer *peer) {
+        enet_list_remove(&peer->addressList);
+        enet_list_insert(enet_list_end(&host->freePeers), &peer->freeList);
+    }
+
+    static void enet_protocol_change_state(ENetHost *host, ENetPeer *peer, ENetPeerState state) {
+        ENET_UNUSED(host)
+
+        if (state == ENET_PEER_STATE_CONNECTED || state == ENET_PEER_STATE_DISCONNECT_LATER) {
+            enet_peer_on_connect(peer);
+        } else {
+            enet_peer_on_disconnect(peer);
+        }
+
+        peer->state = state;
+    }
+
+    static void enet_protocol_dispatch_state(ENetHost *host, ENetPeer *peer, ENetPeerState state) {
+        enet_protocol_change_state(host, peer, state);
+
+        if (!peer->needsDispatch) {
+            enet_list_insert(enet_list_end(&host->dispatchQueue), &peer->dispatchList);
+            peer->needsDispatch = 1;
+        }
+    }
+
+    static int enet_protocol_dispatch_incoming_commands(ENetHost *host, ENetEvent *event) {
+        while (!enet_list_empty(&host->dispatchQueue)) {
+            ENetPeer *peer = (ENetPeer *) enet_list_remove(enet_list_begin(&host->dispatchQueue));
+            peer->needsDispatch = 0;
+
+            switch (peer->state) {
+                case ENET_PEER_STATE_CONNECTION_PENDING:
+                case ENET_PEER_STATE_CONNECTION_SUCCEEDED:
+                    enet_protocol_change_state(host, peer, ENET_PEER_STATE_CONNECTED);
+
+                    event->type = ENET_EVENT_TYPE_CONNECT;
+                    event->peer = peer;
                     event->data = peer->eventData;
 
                     return 1;
@@ -1675,7 +2667,9 @@ extern "C" {
         }
     }
 
-    static ENetProtocolCommand enet_protocol_remove_sent_reliable_command(ENetPeer *peer, enet_uint16 reliableSequenceNumber, enet_uint8 channelID) {
+    static ENetProtocolCommand enet_protocol_remove_sent_reliable_command(ENetPeer *peer, enet_uint16 reliableSequenceNumber, enet_uint8 channelID,
+        enet_uint32 receivedSentTime, enet_uint32 *roundTripTimeMicroseconds
+    ) {
         ENetOutgoingCommand *outgoingCommand = NULL;
         ENetListIterator currentCommand;
         ENetProtocolCommand commandNumber;
@@ -1730,6 +2724,12 @@ extern "C" {
         commandNumber = (ENetProtocolCommand) (outgoingCommand->command.header.command & ENET_PROTOCOL_COMMAND_MASK);
         enet_list_remove(&outgoingCommand->outgoingCommandList);
 
+        // the acknowledgement echoes the millisecond its datagram left, so the microsecond send time
+        // is only the right one when that was the last send and not an earlier one that got lost
+        if (roundTripTimeMicroseconds != NULL && wasSent && outgoingCommand->sentTime == receivedSentTime) {
+            *roundTripTimeMicroseconds = (enet_uint32) peer->host->serviceTimeMicroseconds - outgoingCommand->sentTimeMicroseconds;
+        }
+
         if (outgoingCommand->packet != NULL) {
             if (wasSent) {
                 peer->reliableDataInTransit -= outgoingCommand->fragmentLength;
@@ -1751,6 +2751,7 @@ extern "C" {
 
         outgoingCommand = (ENetOutgoingCommand *) enet_list_front(&peer->sentReliableCommands);
         peer->nextTimeout = outgoingCommand->sentTime + outgoingCommand->roundTripTimeout;
+        enet_peer_schedule_timer(peer);
 
         return commandNumber;
     } /* enet_protocol_remove_sent_reliable_command */
@@ -1764,6 +2765,8 @@ extern "C" {
         size_t channelCount, duplicatePeers = 0;
         ENetPeer *currentPeer, *peer = NULL;
         ENetProtocol verifyCommand;
+        ENetList *bucket;
+        ENetListIterator currentNode;
 
         channelCount = ENET_NET_TO_HOST_32(command->connect.channelCount);
 
@@ -1771,12 +2774,13 @@ extern "C" {
             return NULL;
         }
 
-        for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
-            if (currentPeer->state == ENET_PEER_STATE_DISCONNECTED) {
-                if (peer == NULL) {
-                    peer = currentPeer;
-                }
-            } else if (currentPeer->state != ENET_PEER_STATE_CONNECTING && in6_equal(currentPeer->address.host, host->receivedAddress.host)) {
+        // only the peers hashed to the same bucket can share the address, the rest of the peers don't need looking at
+        bucket = enet_host_address_bucket(host, &host->receivedAddress.host);
+
+        for (currentNode = enet_list_begin(bucket); currentNode != enet_list_end(bucket); currentNode = enet_list_next(currentNode)) {
+            currentPeer = enet_list_peer(currentNode, addressList);
+
+            if (currentPeer->state != ENET_PEER_STATE_CONNECTING && in6_equal(currentPeer->address.host, host->receivedAddress.host)) {
                 if (currentPeer->address.port == host->receivedAddress.port && currentPeer->connectID == command->connect.connectID) {
                     return NULL;
                 }
@@ -1785,10 +2789,12 @@ extern "C" {
             }
         }
 
-        if (peer == NULL || duplicatePeers >= host->duplicatePeers) {
+        if (enet_list_empty(&host->freePeers) || duplicatePeers >= host->duplicatePeers) {
             return NULL;
         }
 
+        peer = enet_list_peer(enet_list_front(&host->freePeers), freeList);
+
         if (channelCount > host->channelLimit) {
             channelCount = host->channelLimit;
         }
@@ -1800,6 +2806,7 @@ extern "C" {
         peer->state                      = ENET_PEER_STATE_ACKNOWLEDGING_CONNECT;
         peer->connectID                  = command->connect.connectID;
         peer->address                    = host->receivedAddress;
+        enet_host_claim_peer(host, peer);
         peer->outgoingPeerID             = ENET_NET_TO_HOST_16(command->connect.outgoingPeerID);
         peer->incomingBandwidth          = ENET_NET_TO_HOST_32(command->connect.incomingBandwidth);
         peer->outgoingBandwidth          = ENET_NET_TO_HOST_32(command->connect.outgoingBandwidth);
@@ -1877,7 +2884,12 @@ extern "C" {
             windowSize = ENET_PROTOCOL_MAXIMUM_WINDOW_SIZE;
         }
 
+        peer->acknowledgeBitfield = (command->header.command & ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE_BITFIELD) != 0;
+
         verifyCommand.header.command                            = ENET_PROTOCOL_COMMAND_VERIFY_CONNECT | ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE;
+        if (peer->acknowledgeBitfield) {
+            verifyCommand.header.command |= ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE_BITFIELD;
+        }
         verifyCommand.header.channelID                          = 0xFF;
         verifyCommand.verifyConnect.outgoingPeerID              = ENET_HOST_TO_NET_16(peer->incomingPeerID);
         verifyCommand.verifyConnect.incomingSessionID           = incomingSessionID;
@@ -1983,12 +2995,43 @@ extern "C" {
         return 0;
     }
 
+    /** Bucket of the peer's fragment table for a fragmented packet, keyed by the reliable start sequence
+     *  number of a reliable one or the unreliable start sequence number of an unreliable one. */
+    static ENetList *enet_peer_fragment_bucket(ENetPeer *peer, enet_uint8 channelID, enet_uint16 startSequenceNumber) {
+        return &peer->fragmentBuckets[(startSequenceNumber + channelID) & (ENET_PEER_FRAGMENT_BUCKETS - 1)];
+    }
+
+    /** Finds the incoming command reassembling the fragmented packet a fragment belongs to, or NULL. */
+    static ENetIncomingCommand *enet_peer_find_fragments(ENetPeer *peer, enet_uint8 commandNumber, enet_uint8 channelID,
+        enet_uint16 reliableSequenceNumber, enet_uint16 unreliableSequenceNumber
+    ) {
+        enet_uint16 startSequenceNumber = commandNumber == ENET_PROTOCOL_COMMAND_SEND_FRAGMENT ? reliableSequenceNumber : unreliableSequenceNumber;
+        ENetList *bucket = enet_peer_fragment_bucket(peer, channelID, startSequenceNumber);
+        ENetListIterator currentCommand;
+
+        for (currentCommand = enet_list_begin(bucket);
+            currentCommand != enet_list_end(bucket);
+            currentCommand = enet_list_next(currentCommand)
+        ) {
+            ENetIncomingCommand *incomingCommand = enet_list_fragments(currentCommand);
+
+            if ((incomingCommand->command.header.command & ENET_PROTOCOL_COMMAND_MASK) == commandNumber &&
+                incomingCommand->command.header.channelID == channelID &&
+                incomingCommand->reliableSequenceNumber == reliableSequenceNumber &&
+                (commandNumber == ENET_PROTOCOL_COMMAND_SEND_FRAGMENT || incomingCommand->unreliableSequenceNumber == unreliableSequenceNumber)
+            ) {
+                return incomingCommand;
+            }
+        }
+
+        return NULL;
+    }
+
     static int enet_protocol_handle_send_fragment(ENetHost *host, ENetPeer *peer, const ENetProtocol *command, enet_uint8 **currentData) {
         enet_uint32 fragmentNumber, fragmentCount, fragmentOffset, fragmentLength, startSequenceNumber, totalLength;
         ENetChannel *channel;
         enet_uint16 startWindow, currentWindow;
-        ENetListIterator currentCommand;
-        ENetIncomingCommand *startCommand = NULL;
+        ENetIncomingCommand *startCommand;
 
         if (command->header.channelID >= peer->channelCount || (peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER)) {
             return -1;
@@ -2027,36 +3070,10 @@ extern "C" {
             return -1;
         }
 
-        for (currentCommand = enet_list_previous(enet_list_end(&channel->incomingReliableCommands));
-            currentCommand != enet_list_end(&channel->incomingReliableCommands);
-            currentCommand = enet_list_previous(currentCommand)
-        ) {
-            ENetIncomingCommand *incomingCommand = (ENetIncomingCommand *) currentCommand;
-
-            if (startSequenceNumber >= channel->incomingReliableSequenceNumber) {
-                if (incomingCommand->reliableSequenceNumber < channel->incomingReliableSequenceNumber) {
-                    continue;
-                }
-            } else if (incomingCommand->reliableSequenceNumber >= channel->incomingReliableSequenceNumber) {
-                break;
-            }
-
-            if (incomingCommand->reliableSequenceNumber <= startSequenceNumber) {
-                if (incomingCommand->reliableSequenceNumber < startSequenceNumber) {
-                    break;
-                }
-
-                if ((incomingCommand->command.header.command & ENET_PROTOCOL_COMMAND_MASK) !=
-                    ENET_PROTOCOL_COMMAND_SEND_FRAGMENT ||
-                    totalLength != incomingCommand->packet->dataLength ||
-                    fragmentCount != incomingCommand->fragmentCount
-                ) {
-                    return -1;
-                }
-
-                startCommand = incomingCommand;
-                break;
-            }
+        // a command with the same start sequence number that isn't this fragmented packet is caught when queueing
+        startCommand = enet_peer_find_fragments(peer, ENET_PROTOCOL_COMMAND_SEND_FRAGMENT, command->header.channelID, startSequenceNumber, 0);
+        if (startCommand != NULL && (totalLength != startCommand->packet->dataLength || fragmentCount != startCommand->fragmentCount)) {
+            return -1;
         }
 
         if (startCommand == NULL) {
@@ -2068,9 +3085,9 @@ extern "C" {
             }
         }
 
-        if ((startCommand->fragments[fragmentNumber / 32] & (1 << (fragmentNumber % 32))) == 0) {
+        if ((startCommand->fragments[fragmentNumber / 32] & (1u << (fragmentNumber % 32))) == 0) {
             --startCommand->fragmentsRemaining;
-            startCommand->fragments[fragmentNumber / 32] |= (1 << (fragmentNumber % 32));
+            startCommand->fragments[fragmentNumber / 32] |= 1u << (fragmentNumber % 32);
 
             if (fragmentOffset + fragmentLength > startCommand->packet->dataLength) {
                 fragmentLength = startCommand->packet->dataLength - fragmentOffset;
@@ -2090,8 +3107,7 @@ extern "C" {
         enet_uint32 fragmentNumber, fragmentCount, fragmentOffset, fragmentLength, reliableSequenceNumber, startSequenceNumber, totalLength;
         enet_uint16 reliableWindow, currentWindow;
         ENetChannel *channel;
-        ENetListIterator currentCommand;
-        ENetIncomingCommand *startCommand = NULL;
+        ENetIncomingCommand *startCommand;
 
         if (command->header.channelID >= peer->channelCount || (peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER)) {
             return -1;
@@ -2136,44 +3152,11 @@ extern "C" {
             return -1;
         }
 
-        for (currentCommand = enet_list_previous(enet_list_end(&channel->incomingUnreliableCommands));
-            currentCommand != enet_list_end(&channel->incomingUnreliableCommands);
-            currentCommand = enet_list_previous(currentCommand)
-        ) {
-            ENetIncomingCommand *incomingCommand = (ENetIncomingCommand *) currentCommand;
-
-            if (reliableSequenceNumber >= channel->incomingReliableSequenceNumber) {
-                if (incomingCommand->reliableSequenceNumber < channel->incomingReliableSequenceNumber) {
-                    continue;
-                }
-            } else if (incomingCommand->reliableSequenceNumber >= channel->incomingReliableSequenceNumber) {
-                break;
-            }
-
-            if (incomingCommand->reliableSequenceNumber < reliableSequenceNumber) {
-                break;
-            }
-
-            if (incomingCommand->reliableSequenceNumber > reliableSequenceNumber) {
-                continue;
-            }
-
-            if (incomingCommand->unreliableSequenceNumber <= startSequenceNumber) {
-                if (incomingCommand->unreliableSequenceNumber < startSequenceNumber) {
-                    break;
-                }
-
-                if ((incomingCommand->command.header.command & ENET_PROTOCOL_COMMAND_MASK) !=
-                    ENET_PROTOCOL_COMMAND_SEND_UNRELIABLE_FRAGMENT ||
-                    totalLength != incomingCommand->packet->dataLength ||
-                    fragmentCount != incomingCommand->fragmentCount
-                ) {
-                    return -1;
-                }
-
-                startCommand = incomingCommand;
-                break;
-            }
+        startCommand = enet_peer_find_fragments(peer, ENET_PROTOCOL_COMMAND_SEND_UNRELIABLE_FRAGMENT, command->header.channelID,
+            reliableSequenceNumber, startSequenceNumber
+        );
+        if (startCommand != NULL && (totalLength != startCommand->packet->dataLength || fragmentCount != startCommand->fragmentCount)) {
+            return -1;
         }
 
         if (startCommand == NULL) {
@@ -2184,9 +3167,9 @@ extern "C" {
             }
         }
 
-        if ((startCommand->fragments[fragmentNumber / 32] & (1 << (fragmentNumber % 32))) == 0) {
+        if ((startCommand->fragments[fragmentNumber / 32] & (1u << (fragmentNumber % 32))) == 0) {
             --startCommand->fragmentsRemaining;
-            startCommand->fragments[fragmentNumber / 32] |= (1 << (fragmentNumber % 32));
+            startCommand->fragments[fragmentNumber / 32] |= 1u << (fragmentNumber % 32);
 
             if (fragmentOffset + fragmentLength > startCommand->packet->dataLength) {
                 fragmentLength = startCommand->packet->dataLength - fragmentOffset;
@@ -2292,8 +3275,11 @@ extern "C" {
         return 0;
     }
 
+    /** Handles ENET_PROTOCOL_COMMAND_ACKNOWLEDGE and ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD. The base sequence number
+     *  supplies the round trip time sample, the bitfield only retires the other commands of the same datagram. */
     static int enet_protocol_handle_acknowledge(ENetHost *host, ENetEvent *event, ENetPeer *peer, const ENetProtocol *command) {
-        enet_uint32 roundTripTime, receivedSentTime, receivedReliableSequenceNumber;
+        enet_uint32 roundTripTime, roundTripTimeMicroseconds, receivedSentTime, receivedReliableSequenceNumber, receivedBitfield = 0;
+        enet_uint32 reliableDataInTransit = peer->reliableDataInTransit;
         ENetProtocolCommand commandNumber;
 
         if (peer->state == ENET_PEER_STATE_DISCONNECTED || peer->state == ENET_PEER_STATE_ZOMBIE) {
@@ -2313,16 +3299,45 @@ extern "C" {
         peer->lastReceiveTime = host->serviceTime;
         peer->earliestTimeout = 0;
         roundTripTime = ENET_TIME_DIFFERENCE(host->serviceTime, receivedSentTime);
+        roundTripTimeMicroseconds = roundTripTime * 1000;
+
+        if ((command->header.command & ENET_PROTOCOL_COMMAND_MASK) == ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD) {
+            receivedBitfield = ENET_NET_TO_HOST_32(command->acknowledgeBitfield.receivedBitfield);
+        }
+
+        receivedReliableSequenceNumber = ENET_NET_TO_HOST_16(command->acknowledge.receivedReliableSequenceNumber);
+        commandNumber = enet_protocol_remove_sent_reliable_command(peer, receivedReliableSequenceNumber, command->header.channelID,
+            receivedSentTime, &roundTripTimeMicroseconds
+        );
+
+        if (host->congestionControl.context == NULL) {
+            enet_peer_throttle(peer, roundTripTime);
+        }
 
-        enet_peer_throttle(peer, roundTripTime);
-        peer->roundTripTimeVariance -= peer->roundTripTimeVariance / 4;
+        if (host->clockMode == ENET_HOST_CLOCK_MICROSECONDS) {
+            // same estimator in microseconds, the millisecond fields are its values rounded up
+            peer->roundTripTimeVarianceMicroseconds -= peer->roundTripTimeVarianceMicroseconds / 4;
 
-        if (roundTripTime >= peer->roundTripTime) {
-            peer->roundTripTime         += (roundTripTime - peer->roundTripTime) / 8;
-            peer->roundTripTimeVariance += (roundTripTime - peer->roundTripTime) / 4;
+            if (roundTripTimeMicroseconds >= peer->roundTripTimeMicroseconds) {
+                peer->roundTripTimeMicroseconds         += (roundTripTimeMicroseconds - peer->roundTripTimeMicroseconds) / 8;
+                peer->roundTripTimeVarianceMicroseconds += (roundTripTimeMicroseconds - peer->roundTripTimeMicroseconds) / 4;
+            } else {
+                peer->roundTripTimeMicroseconds         -= (peer->roundTripTimeMicroseconds - roundTripTimeMicroseconds) / 8;
+                peer->roundTripTimeVarianceMicroseconds += (peer->roundTripTimeMicroseconds - roundTripTimeMicroseconds) / 4;
+            }
+
+            peer->roundTripTime         = (peer->roundTripTimeMicroseconds + 999) / 1000;
+            peer->roundTripTimeVariance = (peer->roundTripTimeVarianceMicroseconds + 999) / 1000;
         } else {
-            peer->roundTripTime         -= (peer->roundTripTime - roundTripTime) / 8;
-            peer->roundTripTimeVariance += (peer->roundTripTime - roundTripTime) / 4;
+            peer->roundTripTimeVariance -= peer->roundTripTimeVariance / 4;
+
+            if (roundTripTime >= peer->roundTripTime) {
+                peer->roundTripTime         += (roundTripTime - peer->roundTripTime) / 8;
+                peer->roundTripTimeVariance += (roundTripTime - peer->roundTripTime) / 4;
+            } else {
+                peer->roundTripTime         -= (peer->roundTripTime - roundTripTime) / 8;
+                peer->roundTripTimeVariance += (peer->roundTripTime - roundTripTime) / 4;
+            }
         }
 
         if (peer->roundTripTime < peer->lowestRoundTripTime) {
@@ -2343,37 +3358,58 @@ extern "C" {
             peer->packetThrottleEpoch          = host->serviceTime;
         }
 
-        receivedReliableSequenceNumber = ENET_NET_TO_HOST_16(command->acknowledge.receivedReliableSequenceNumber);
-        commandNumber = enet_protocol_remove_sent_reliable_command(peer, receivedReliableSequenceNumber, command->header.channelID);
+        for (;;) {
+            switch (peer->state) {
+                case ENET_PEER_STATE_ACKNOWLEDGING_CONNECT:
+                    if (commandNumber != ENET_PROTOCOL_COMMAND_VERIFY_CONNECT) {
+                        return -1;
+                    }
 
-        switch (peer->state) {
-            case ENET_PEER_STATE_ACKNOWLEDGING_CONNECT:
-                if (commandNumber != ENET_PROTOCOL_COMMAND_VERIFY_CONNECT) {
-                    return -1;
-                }
+                    enet_protocol_notify_connect(host, peer, event);
+                    break;
 
-                enet_protocol_notify_connect(host, peer, event);
-                break;
+                case ENET_PEER_STATE_DISCONNECTING:
+                    if (commandNumber != ENET_PROTOCOL_COMMAND_DISCONNECT) {
+                        return -1;
+                    }
 
-            case ENET_PEER_STATE_DISCONNECTING:
-                if (commandNumber != ENET_PROTOCOL_COMMAND_DISCONNECT) {
-                    return -1;
-                }
+                    enet_protocol_notify_disconnect(host, peer, event);
+                    break;
 
-                enet_protocol_notify_disconnect(host, peer, event);
-                break;
+                case ENET_PEER_STATE_DISCONNECT_LATER:
+                    if (enet_list_empty(&peer->outgoingReliableCommands) &&
+                      enet_list_empty(&peer->outgoingUnreliableCommands) &&
+                      enet_list_empty(&peer->sentReliableCommands))
+                    {
+                        enet_peer_disconnect(peer, peer->eventData);
+                    }
+                    break;
 
-            case ENET_PEER_STATE_DISCONNECT_LATER:
-                if (enet_list_empty(&peer->outgoingReliableCommands) &&
-                  enet_list_empty(&peer->outgoingUnreliableCommands) &&
-                  enet_list_empty(&peer->sentReliableCommands))
-                {
-                    enet_peer_disconnect(peer, peer->eventData);
-                }
-                break;
+                default:
+                    break;
+            }
 
-            default:
+            if (receivedBitfield == 0 || peer->state == ENET_PEER_STATE_DISCONNECTED || peer->state == ENET_PEER_STATE_ZOMBIE) {
                 break;
+            }
+
+            while (!(receivedBitfield & 1)) {
+                receivedBitfield >>= 1;
+                ++receivedReliableSequenceNumber;
+            }
+
+            receivedBitfield >>= 1;
+            ++receivedReliableSequenceNumber;
+
+            commandNumber = enet_protocol_remove_sent_reliable_command(peer, (enet_uint16) receivedReliableSequenceNumber,
+                command->header.channelID, 0, NULL
+            );
+        }
+
+        if (host->congestionControl.context != NULL && peer->state != ENET_PEER_STATE_DISCONNECTED && peer->state != ENET_PEER_STATE_ZOMBIE) {
+            host->congestionControl.acknowledge(host->congestionControl.context, peer, roundTripTimeMicroseconds,
+                reliableDataInTransit > peer->reliableDataInTransit ? reliableDataInTransit - peer->reliableDataInTransit : 0
+            );
         }
 
         return 0;
@@ -2400,7 +3436,7 @@ extern "C" {
             return -1;
         }
 
-        enet_protocol_remove_sent_reliable_command(peer, 1, 0xFF);
+        enet_protocol_remove_sent_reliable_command(peer, 1, 0xFF, 0, NULL);
 
         if (channelCount < peer->channelCount) {
             peer->channelCount = channelCount;
@@ -2409,6 +3445,7 @@ extern "C" {
         peer->outgoingPeerID    = ENET_NET_TO_HOST_16(command->verifyConnect.outgoingPeerID);
         peer->incomingSessionID = command->verifyConnect.incomingSessionID;
         peer->outgoingSessionID = command->verifyConnect.outgoingSessionID;
+        peer->acknowledgeBitfield = (command->header.command & ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE_BITFIELD) != 0;
 
         mtu = ENET_NET_TO_HOST_32(command->verifyConnect.mtu);
 
@@ -2487,24 +3524,37 @@ extern "C" {
         }
 
         if (flags & ENET_PROTOCOL_HEADER_FLAG_COMPRESSED) {
-            size_t originalSize;
+            enet_uint8 *decompressed = host->packetData[1];
+            size_t originalSize, decompressedLimit = sizeof(host->packetData[1]);
+
             if (host->compressor.context == NULL || host->compressor.decompress == NULL) {
                 return 0;
             }
 
+            // expand into a pool buffer so the packets can point into the expanded datagram
+            if (host->receivePool != NULL) {
+                if (enet_host_renew_receive_buffer(host, &host->decompressBuffer) != 0) {
+                    return -1;
+                }
+
+                decompressed         = host->decompressBuffer->data;
+                decompressedLimit    = ENET_PROTOCOL_MAXIMUM_MTU;
+                host->receivedBuffer = host->decompressBuffer;
+            }
+
             originalSize = host->compressor.decompress(host->compressor.context,
                 host->receivedData + headerSize,
                 host->receivedDataLength - headerSize,
-                host->packetData[1] + headerSize,
-                sizeof(host->packetData[1]) - headerSize
+                decompressed + headerSize,
+                decompressedLimit - headerSize
             );
 
-            if (originalSize <= 0 || originalSize > sizeof(host->packetData[1]) - headerSize) {
+            if (originalSize <= 0 || originalSize > decompressedLimit - headerSize) {
                 return 0;
             }
 
-            memcpy(host->packetData[1], header, headerSize);
-            host->receivedData       = host->packetData[1];
+            memcpy(decompressed, header, headerSize);
+            host->receivedData       = decompressed;
             host->receivedDataLength = headerSize + originalSize;
         }
 
@@ -2562,6 +3612,7 @@ extern "C" {
 
             switch (commandNumber) {
                 case ENET_PROTOCOL_COMMAND_ACKNOWLEDGE:
+                case ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD:
                     if (enet_protocol_handle_acknowledge(host, event, peer, command)) {
                         goto commandError;
                     }
@@ -2682,28 +3733,75 @@ extern "C" {
         int packets;
 
         for (packets = 0; packets < 256; ++packets) {
-            int receivedLength;
-            ENetBuffer buffer;
+            ENetBuffer *buffer;
+            size_t segmentSize, receivedLength;
 
-            buffer.data       = host->packetData[0];
-            // buffer.dataLength = sizeof (host->packetData[0]);
-            buffer.dataLength = host->mtu;
+            if (host->receiveBatchIndex >= host->receiveBatchCount) {
+                int receivedCount;
+                size_t i;
 
-            receivedLength    = enet_socket_receive(host->socket, &host->receivedAddress, &buffer, 1);
+                for (i = 0; i < host->receiveBufferCount; ++i) {
+                    host->receiveBatch[i].data       = host->receiveBuffers + i * host->receiveBufferSize;
+                    host->receiveBatch[i].dataLength = host->receiveBufferSize;
 
-            if (receivedLength == -2)
-                continue;
+                    // packets still pointing into a slot's buffer keep it, the slot gets another one
+                    if (host->receivePool != NULL) {
+                        if (enet_host_renew_receive_buffer(host, &host->receiveSlots[i]) != 0) {
+                            return -1;
+                        }
 
-            if (receivedLength < 0) {
-                return -1;
+                        host->receiveBatch[i].data = host->receiveSlots[i]->data;
+                    }
+                }
+
+                host->receiveBatchCount  = 0;
+                host->receiveBatchIndex  = 0;
+                host->receiveBatchOffset = 0;
+
+            #ifdef ENET_USE_IO_URING
+                // io_uring points the batch at whichever of its posted buffers completed
+                if (host->uring != NULL) {
+                    receivedCount = enet_uring_receive_batch(host);
+                } else
+            #endif
+                receivedCount = enet_socket_receive_batch(host->socket, host->receiveAddresses, host->receiveBatch, host->receiveBufferCount, host->receiveSegmentSizes);
+
+                if (receivedCount < 0) {
+                    return -1;
+                }
+
+                if (receivedCount == 0) {
+                    return 0;
+                }
+
+                host->receiveBatchCount = (size_t) receivedCount;
             }
 
-            if (receivedLength == 0) {
-                return 0;
+            // datagrams left in the batch when we return with an event are picked up on the next call
+            buffer                = &host->receiveBatch[host->receiveBatchIndex];
+            segmentSize           = host->receiveSegmentSizes[host->receiveBatchIndex];
+            host->receivedAddress = host->receiveAddresses[host->receiveBatchIndex];
+
+            // a coalesced buffer holds several datagrams of segmentSize bytes, the last one may be shorter
+            receivedLength = buffer->dataLength - host->receiveBatchOffset;
+            if (segmentSize > 0 && receivedLength > segmentSize) {
+                receivedLength = segmentSize;
+            }
+
+            host->receivedData        = (enet_uint8 *) buffer->data + host->receiveBatchOffset;
+            host->receivedDataLength  = receivedLength;
+            host->receivedBuffer      = host->receivePool != NULL ? host->receiveSlots[host->receiveBatchIndex] : NULL;
+            host->receiveBatchOffset += receivedLength;
+
+            if (host->receiveBatchOffset >= buffer->dataLength) {
+                ++host->receiveBatchIndex;
+                host->receiveBatchOffset = 0;
             }
 
-            host->receivedData       = host->packetData[0];
-            host->receivedDataLength = receivedLength;
+            // truncated datagrams come back empty, drop them without failing the rest of the batch
+            if (receivedLength == 0) {
+                continue;
+            }
 
             host->totalReceivedData += receivedLength;
             host->totalReceivedPackets++;
@@ -2737,22 +3835,24 @@ extern "C" {
             }
         }
 
-        return -1;
+        // hitting the per-call budget is not an error, the remaining datagrams are handled on the next pass
+        return 0;
     } /* enet_protocol_receive_incoming_commands */
 
     static void enet_protocol_send_acknowledgements(ENetHost *host, ENetPeer *peer) {
         ENetProtocol *command = &host->commands[host->commandCount];
         ENetBuffer *buffer    = &host->buffers[host->bufferCount];
-        ENetAcknowledgement *acknowledgement;
+        ENetAcknowledgement *acknowledgement, *nextAcknowledgement;
         ENetListIterator currentAcknowledgement;
-        enet_uint16 reliableSequenceNumber;
+        enet_uint16 reliableSequenceNumber, offset;
+        enet_uint32 receivedBitfield;
 
         currentAcknowledgement = enet_list_begin(&peer->acknowledgements);
 
         while (currentAcknowledgement != enet_list_end(&peer->acknowledgements)) {
-            if (command >= &host->commands[sizeof(host->commands) / sizeof(ENetProtocol)] ||
-                buffer >= &host->buffers[sizeof(host->buffers) / sizeof(ENetBuffer)] ||
-                peer->mtu - host->packetSize < sizeof(ENetProtocolAcknowledge)
+            if (command >= &host->commands[ENET_PROTOCOL_MAXIMUM_PACKET_COMMANDS] ||
+                buffer >= &host->buffers[ENET_BUFFER_MAXIMUM] ||
+                peer->mtu - host->packetSize < (peer->acknowledgeBitfield ? sizeof(ENetProtocolAcknowledgeBitfield) : sizeof(ENetProtocolAcknowledge))
             ) {
                 host->continueSending = 1;
                 break;
@@ -2761,22 +3861,52 @@ extern "C" {
             acknowledgement = (ENetAcknowledgement *) currentAcknowledgement;
             currentAcknowledgement = enet_list_next(currentAcknowledgement);
 
-            buffer->data       = command;
-            buffer->dataLength = sizeof(ENetProtocolAcknowledge);
-            host->packetSize += buffer->dataLength;
+            reliableSequenceNumber = acknowledgement->command.header.reliableSequenceNumber;
+            receivedBitfield = 0;
+
+            if ((acknowledgement->command.header.command & ENET_PROTOCOL_COMMAND_MASK) == ENET_PROTOCOL_COMMAND_DISCONNECT) {
+                enet_protocol_dispatch_state(host, peer, ENET_PEER_STATE_ZOMBIE);
+            } else if (peer->acknowledgeBitfield) {
+                // commands of one datagram are queued back to back in ascending order, so fold the run
+                // that shares the channel and sent time into the bitfield above the first one
+                while (currentAcknowledgement != enet_list_end(&peer->acknowledgements)) {
+                    nextAcknowledgement = (ENetAcknowledgement *) currentAcknowledgement;
+                    offset = nextAcknowledgement->command.header.reliableSequenceNumber - reliableSequenceNumber;
+
+                    if (nextAcknowledgement->sentTime != acknowledgement->sentTime ||
+                        nextAcknowledgement->command.header.channelID != acknowledgement->command.header.channelID ||
+                        (nextAcknowledgement->command.header.command & ENET_PROTOCOL_COMMAND_MASK) == ENET_PROTOCOL_COMMAND_DISCONNECT ||
+                        offset == 0 || offset > 32
+                    ) {
+                        break;
+                    }
 
-            reliableSequenceNumber = ENET_HOST_TO_NET_16(acknowledgement->command.header.reliableSequenceNumber);
+                    receivedBitfield |= 1u << (offset - 1);
+                    currentAcknowledgement = enet_list_next(currentAcknowledgement);
+
+                    enet_list_remove(&nextAcknowledgement->acknowledgementList);
+                    enet_free(nextAcknowledgement);
+                }
+            }
+
+            buffer->data = command;
 
-            command->header.command   = ENET_PROTOCOL_COMMAND_ACKNOWLEDGE;
             command->header.channelID = acknowledgement->command.header.channelID;
-            command->header.reliableSequenceNumber = reliableSequenceNumber;
-            command->acknowledge.receivedReliableSequenceNumber = reliableSequenceNumber;
+            command->header.reliableSequenceNumber = ENET_HOST_TO_NET_16(reliableSequenceNumber);
+            command->acknowledge.receivedReliableSequenceNumber = ENET_HOST_TO_NET_16(reliableSequenceNumber);
             command->acknowledge.receivedSentTime = ENET_HOST_TO_NET_16(acknowledgement->sentTime);
 
-            if ((acknowledgement->command.header.command & ENET_PROTOCOL_COMMAND_MASK) == ENET_PROTOCOL_COMMAND_DISCONNECT) {
-                enet_protocol_dispatch_state(host, peer, ENET_PEER_STATE_ZOMBIE);
+            if (receivedBitfield != 0) {
+                buffer->dataLength = sizeof(ENetProtocolAcknowledgeBitfield);
+                command->header.command = ENET_PROTOCOL_COMMAND_ACKNOWLEDGE_BITFIELD;
+                command->acknowledgeBitfield.receivedBitfield = ENET_HOST_TO_NET_32(receivedBitfield);
+            } else {
+                buffer->dataLength = sizeof(ENetProtocolAcknowledge);
+                command->header.command = ENET_PROTOCOL_COMMAND_ACKNOWLEDGE;
             }
 
+            host->packetSize += buffer->dataLength;
+
             enet_list_remove(&acknowledgement->acknowledgementList);
             enet_free(acknowledgement);
 
@@ -2788,6 +3918,91 @@ extern "C" {
         host->bufferCount  = buffer - host->buffers;
     } /* enet_protocol_send_acknowledgements */
 
+    /** Finishes a deferred disconnect once everything queued on the peer is out. Unreliable commands
+     *  sit in sentUnreliableCommands until their datagram has been flushed, and enet_peer_disconnect
+     *  frees them, so it has to wait for that too.
+     */
+    static void enet_protocol_check_disconnect_later(ENetPeer *peer) {
+        if (peer->state == ENET_PEER_STATE_DISCONNECT_LATER &&
+          enet_list_empty(&peer->outgoingReliableCommands) &&
+          enet_list_empty(&peer->outgoingUnreliableCommands) &&
+          enet_list_empty(&peer->sentReliableCommands) &&
+          enet_list_empty(&peer->sentUnreliableCommands))
+        {
+            enet_peer_disconnect(peer, peer->eventData);
+        }
+    }
+
+    /** Sends every datagram staged in host->sendBatch, then releases the unreliable commands they carried. */
+    static int enet_protocol_flush_datagrams(ENetHost *host) {
+        ENetDatagram *datagram;
+        int result = 0, segmentation = (host->offload & ENET_HOST_OFFLOAD_SEGMENT) != 0;
+
+        if (host->sendBatchCount == 0) {
+            return 0;
+        }
+
+        if (host->sendIntercept != NULL) {
+            for (datagram = host->sendBatch; datagram < &host->sendBatch[host->sendBatchCount]; ++datagram) {
+                size_t dataLength = 0, i;
+
+                for (i = 0; i < datagram->bufferCount; ++i) {
+                    dataLength += datagram->buffers[i].dataLength;
+                }
+
+                switch (host->sendIntercept(host, &datagram->address, datagram->buffers, datagram->bufferCount, dataLength)) {
+                    case 1:
+                        datagram->sentLength = (int) dataLength;
+                        break;
+
+                    case 0:
+                        datagram->sentLength = enet_socket_send(host->socket, &datagram->address, datagram->buffers, datagram->bufferCount);
+                        if (datagram->sentLength < 0) {
+                            result = -1;
+                        }
+                        break;
+
+                    default:
+                        result = -1;
+                        break;
+                }
+            }
+        } else
+    #ifdef ENET_USE_IO_URING
+        if (host->uring != NULL) {
+            if (enet_uring_send_batch(host, host->sendBatch, host->sendBatchCount) < 0) {
+                result = -1;
+            }
+        } else
+    #endif
+        if (enet_socket_send_batch(host->socket, host->sendBatch, host->sendBatchCount, &segmentation) < 0) {
+            result = -1;
+        }
+
+        // the socket turns segmentation off if the kernel or the route refuses it, don't try it again
+        if (!segmentation) {
+            host->offload &= ~ENET_HOST_OFFLOAD_SEGMENT;
+        }
+
+        for (datagram = host->sendBatch; datagram < &host->sendBatch[host->sendBatchCount]; ++datagram) {
+            enet_protocol_remove_sent_unreliable_commands(datagram->peer);
+
+            if (result == 0) {
+                host->totalSentData += datagram->sentLength;
+                datagram->peer->totalDataSent += datagram->sentLength;
+                host->totalSentPackets++;
+            }
+        }
+
+        for (datagram = host->sendBatch; datagram < &host->sendBatch[host->sendBatchCount]; ++datagram) {
+            enet_protocol_check_disconnect_later(datagram->peer);
+        }
+
+        host->sendBatchCount = 0;
+
+        return result;
+    } /* enet_protocol_flush_datagrams */
+
     static void enet_protocol_send_unreliable_outgoing_commands(ENetHost *host, ENetPeer *peer) {
         ENetProtocol *command = &host->commands[host->commandCount];
         ENetBuffer *buffer    = &host->buffers[host->bufferCount];
@@ -2801,8 +4016,8 @@ extern "C" {
             outgoingCommand = (ENetOutgoingCommand *) currentCommand;
             commandSize     = commandSizes[outgoingCommand->command.header.command & ENET_PROTOCOL_COMMAND_MASK];
 
-            if (command >= &host->commands[sizeof(host->commands) / sizeof(ENetProtocol)] ||
-                buffer + 1 >= &host->buffers[sizeof(host->buffers) / sizeof(ENetBuffer)] ||
+            if (command >= &host->commands[ENET_PROTOCOL_MAXIMUM_PACKET_COMMANDS] ||
+                buffer + 1 >= &host->buffers[ENET_BUFFER_MAXIMUM] ||
                 peer->mtu - host->packetSize < commandSize ||
                 (outgoingCommand->packet != NULL &&
                 peer->mtu - host->packetSize < commandSize + outgoingCommand->fragmentLength)
@@ -2872,18 +4087,58 @@ extern "C" {
         host->commandCount = command - host->commands;
         host->bufferCount  = buffer - host->buffers;
 
-        if (peer->state == ENET_PEER_STATE_DISCONNECT_LATER &&
-          enet_list_empty(&peer->outgoingReliableCommands) &&
-          enet_list_empty(&peer->outgoingUnreliableCommands) &&
-          enet_list_empty(&peer->sentReliableCommands))
-        {
-            enet_peer_disconnect(peer, peer->eventData);
-        }
+        enet_protocol_check_disconnect_later(peer);
     } /* enet_protocol_send_unreliable_outgoing_commands */
 
+    /** Retransmission timeout of a reliable command sent to the peer now, in milliseconds. With
+     *  ENET_HOST_CLOCK_MICROSECONDS it is worked out from the microsecond estimate and rounded up
+     *  once, instead of adding up the rounded millisecond fields.
+     */
+    static enet_uint32 enet_peer_round_trip_timeout(ENetPeer *peer) {
+        if (peer->host->clockMode == ENET_HOST_CLOCK_MICROSECONDS) {
+            return (peer->roundTripTimeMicroseconds + 4 * peer->roundTripTimeVarianceMicroseconds + 999) / 1000;
+        }
+
+        return peer->roundTripTime + 4 * peer->roundTripTimeVariance;
+    }
+
+    /** Bytes of reliable data the peer may have in transit for this pass over its outgoing commands. With a
+     *  congestion control attached this also tops up the pacing credit, which spreads the window over one
+     *  round trip time; the credit can bank at most a quarter of the window, so an idle peer doesn't burst. */
+    static enet_uint32 enet_peer_send_window(ENetPeer *peer) {
+        ENetHost *host = peer->host;
+        enet_uint32 windowSize, elapsed, roundTripTime;
+        enet_uint64 credit, limit;
+
+        if (host->congestionControl.context == NULL) {
+            return (peer->packetThrottle * peer->windowSize) / ENET_PEER_PACKET_THROTTLE_SCALE;
+        }
+
+        windowSize = host->congestionControl.window(host->congestionControl.context, peer);
+        elapsed    = ENET_TIME_DIFFERENCE(host->serviceTime, peer->pacingTime);
+
+        if (elapsed > 0) {
+            roundTripTime = ENET_MAX(enet_peer_get_rtt_us(peer), 1000);
+            limit  = ENET_MAX(windowSize / 4, ENET_PEER_CONGESTION_MINIMUM_WINDOW * peer->mtu);
+            credit = (enet_uint64) windowSize * elapsed * 1000 / roundTripTime;
+
+            if (peer->pacingCredit >= 0) {
+                credit += (enet_uint64) peer->pacingCredit;
+            } else {
+                credit = credit > (enet_uint64) -peer->pacingCredit ? credit - (enet_uint64) -peer->pacingCredit : 0;
+            }
+
+            peer->pacingCredit = (int) ENET_MIN(credit, limit);
+            peer->pacingTime   = host->serviceTime;
+        }
+
+        return windowSize;
+    }
+
     static int enet_protocol_check_timeouts(ENetHost *host, ENetPeer *peer, ENetEvent *event) {
         ENetOutgoingCommand *outgoingCommand;
         ENetListIterator currentCommand, insertPosition;
+        int lost = 0;
 
         currentCommand = enet_list_begin(&peer->sentReliableCommands);
         insertPosition = enet_list_begin(&peer->outgoingReliableCommands);
@@ -2906,6 +4161,8 @@ extern "C" {
                 (outgoingCommand->roundTripTimeout >= outgoingCommand->roundTripTimeoutLimit &&
                 ENET_TIME_DIFFERENCE(host->serviceTime, peer->earliestTimeout) >= peer->timeoutMinimum))
             ) {
+                // the reset frees the peer's packets, which staged datagrams may still point at
+                enet_protocol_flush_datagrams(host);
                 enet_protocol_notify_disconnect_timeout(host, peer, event);
                 return 1;
             }
@@ -2916,10 +4173,11 @@ extern "C" {
 
             ++peer->packetsLost;
             ++peer->totalPacketsLost;
+            lost = 1;
 
             /* Replaced exponential backoff time with something more linear */
             /* Source: http://lists.cubik.org/pipermail/enet-discuss/2014-May/002308.html */
-            outgoingCommand->roundTripTimeout = peer->roundTripTime + 4 * peer->roundTripTimeVariance;
+            outgoingCommand->roundTripTimeout = enet_peer_round_trip_timeout(peer);
             outgoingCommand->roundTripTimeoutLimit = peer->timeoutLimit * outgoingCommand->roundTripTimeout;
 
             enet_list_insert(insertPosition, enet_list_remove(&outgoingCommand->outgoingCommandList));
@@ -2930,6 +4188,10 @@ extern "C" {
             }
         }
 
+        if (lost && host->congestionControl.context != NULL) {
+            host->congestionControl.loss(host->congestionControl.context, peer);
+        }
+
         return 0;
     } /* enet_protocol_check_timeouts */
 
@@ -2942,6 +4204,7 @@ extern "C" {
         enet_uint16 reliableWindow;
         size_t commandSize;
         int windowExceeded = 0, windowWrap = 0, canPing = 1;
+        enet_uint32 windowSize = 0;
 
         currentCommand = enet_list_begin(&peer->outgoingReliableCommands);
 
@@ -2970,9 +4233,13 @@ extern "C" {
 
             if (outgoingCommand->packet != NULL) {
                 if (!windowExceeded) {
-                    enet_uint32 windowSize = (peer->packetThrottle * peer->windowSize) / ENET_PEER_PACKET_THROTTLE_SCALE;
+                    if (windowSize == 0) {
+                        windowSize = enet_peer_send_window(peer);
+                    }
 
-                    if (peer->reliableDataInTransit + outgoingCommand->fragmentLength > ENET_MAX(windowSize, peer->mtu)) {
+                    if (peer->reliableDataInTransit + outgoingCommand->fragmentLength > ENET_MAX(windowSize, peer->mtu) ||
+                        (host->congestionControl.context != NULL && peer->pacingCredit <= 0)
+                    ) {
                         windowExceeded = 1;
                     }
                 }
@@ -2986,8 +4253,8 @@ extern "C" {
             canPing = 0;
 
             commandSize = commandSizes[outgoingCommand->command.header.command & ENET_PROTOCOL_COMMAND_MASK];
-            if (command >= &host->commands[sizeof(host->commands) / sizeof(ENetProtocol)] ||
-                buffer + 1 >= &host->buffers[sizeof(host->buffers) / sizeof(ENetBuffer)] ||
+            if (command >= &host->commands[ENET_PROTOCOL_MAXIMUM_PACKET_COMMANDS] ||
+                buffer + 1 >= &host->buffers[ENET_BUFFER_MAXIMUM] ||
                 peer->mtu - host->packetSize < commandSize ||
                 (outgoingCommand->packet != NULL &&
                 (enet_uint16) (peer->mtu - host->packetSize) < (enet_uint16) (commandSize + outgoingCommand->fragmentLength))
@@ -3006,7 +4273,7 @@ extern "C" {
             ++outgoingCommand->sendAttempts;
 
             if (outgoingCommand->roundTripTimeout == 0) {
-                outgoingCommand->roundTripTimeout      = peer->roundTripTime + 4 * peer->roundTripTimeVariance;
+                outgoingCommand->roundTripTimeout      = enet_peer_round_trip_timeout(peer);
                 outgoingCommand->roundTripTimeoutLimit = peer->timeoutLimit * outgoingCommand->roundTripTimeout;
             }
 
@@ -3016,7 +4283,8 @@ extern "C" {
 
             enet_list_insert(enet_list_end(&peer->sentReliableCommands), enet_list_remove(&outgoingCommand->outgoingCommandList));
 
-            outgoingCommand->sentTime = host->serviceTime;
+            outgoingCommand->sentTime             = host->serviceTime;
+            outgoingCommand->sentTimeMicroseconds = (enet_uint32) host->serviceTimeMicroseconds;
 
             buffer->data       = command;
             buffer->dataLength = commandSize;
@@ -3032,6 +4300,7 @@ extern "C" {
                 buffer->dataLength = outgoingCommand->fragmentLength;
                 host->packetSize += outgoingCommand->fragmentLength;
                 peer->reliableDataInTransit += outgoingCommand->fragmentLength;
+                peer->pacingCredit -= (int) outgoingCommand->fragmentLength;
             }
 
             ++peer->packetsSent;
@@ -3048,19 +4317,45 @@ extern "C" {
     } /* enet_protocol_send_reliable_outgoing_commands */
 
     static int enet_protocol_send_outgoing_commands(ENetHost *host, ENetEvent *event, int checkForTimeouts) {
-        enet_uint8 headerData[sizeof(ENetProtocolHeader) + sizeof(enet_uint32)];
-        ENetProtocolHeader *header = (ENetProtocolHeader *) headerData;
+        ENetProtocolHeader *header;
+        ENetDatagram *datagram;
         ENetPeer *currentPeer;
-        int sentLength;
+        ENetListIterator currentNode;
         size_t shouldCompress = 0;
         host->continueSending = 1;
 
+        // peers with nothing to send only need a datagram when a retransmission or a ping is due, the timer wheel queues those
+        enet_host_expire_timers(host, host->serviceTime);
+
         while (host->continueSending)
-            for (host->continueSending = 0, currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
+            for (host->continueSending = 0, currentNode = enet_list_begin(&host->sendQueue); currentNode != enet_list_end(&host->sendQueue);) {
+                currentPeer = enet_list_peer(currentNode, sendList);
+
+                // the peer can be reset while it is handled, which takes it off the queue
+                currentNode = enet_list_next(currentNode);
+
                 if (currentPeer->state == ENET_PEER_STATE_DISCONNECTED || currentPeer->state == ENET_PEER_STATE_ZOMBIE) {
                     continue;
                 }
 
+                // peers that have sent everything and whose timer has not come up leave the queue until they have something again
+                if (enet_list_empty(&currentPeer->acknowledgements) &&
+                    enet_list_empty(&currentPeer->outgoingReliableCommands) &&
+                    enet_list_empty(&currentPeer->outgoingUnreliableCommands) &&
+                    currentPeer->timerScheduled &&
+                    ENET_TIME_LESS(host->serviceTime, currentPeer->timerDeadline)
+                ) {
+                    enet_list_remove(&currentPeer->sendList);
+                    currentPeer->needsSend = 0;
+                    continue;
+                }
+
+                // build straight into the next free slot of the send batch
+                datagram = &host->sendBatch[host->sendBatchCount];
+                header   = (ENetProtocolHeader *) datagram->headerData;
+
+                host->commands     = datagram->commands;
+                host->buffers      = datagram->buffers;
                 host->headerFlags  = 0;
                 host->commandCount = 0;
                 host->bufferCount  = 1;
@@ -3076,7 +4371,7 @@ extern "C" {
                     enet_protocol_check_timeouts(host, currentPeer, event) == 1
                 ) {
                     if (event != NULL && event->type != ENET_EVENT_TYPE_NONE) {
-                        return 1;
+                        return enet_protocol_flush_datagrams(host) < 0 ? -1 : 1;
                     } else {
                         continue;
                     }
@@ -3097,6 +4392,7 @@ extern "C" {
                 }
 
                 if (host->commandCount == 0) {
+                    enet_peer_schedule_timer(currentPeer);
                     continue;
                 }
 
@@ -3133,7 +4429,7 @@ extern "C" {
                     currentPeer->packetsLost     = 0;
                 }
 
-                host->buffers->data = headerData;
+                host->buffers->data = datagram->headerData;
                 if (host->headerFlags & ENET_PROTOCOL_HEADER_FLAG_SENT_TIME) {
                     header->sentTime = ENET_HOST_TO_NET_16(host->serviceTime & 0xFFFF);
                     host->buffers->dataLength = sizeof(ENetProtocolHeader);
@@ -3144,7 +4440,7 @@ extern "C" {
                 shouldCompress = 0;
                 if (host->compressor.context != NULL && host->compressor.compress != NULL) {
                     size_t originalSize = host->packetSize - sizeof(ENetProtocolHeader),
-                      compressedSize    = host->compressor.compress(host->compressor.context, &host->buffers[1], host->bufferCount - 1, originalSize, host->packetData[1], originalSize);
+                      compressedSize    = host->compressor.compress(host->compressor.context, &host->buffers[1], host->bufferCount - 1, originalSize, datagram->compressedData, originalSize);
                     if (compressedSize > 0 && compressedSize < originalSize) {
                         host->headerFlags |= ENET_PROTOCOL_HEADER_FLAG_COMPRESSED;
                         shouldCompress     = compressedSize;
@@ -3159,34 +4455,85 @@ extern "C" {
                 }
                 header->peerID = ENET_HOST_TO_NET_16(currentPeer->outgoingPeerID | host->headerFlags);
                 if (host->checksum != NULL) {
-                    enet_uint32 *checksum = (enet_uint32 *) &headerData[host->buffers->dataLength];
+                    enet_uint32 *checksum = (enet_uint32 *) &datagram->headerData[host->buffers->dataLength];
                     *checksum = currentPeer->outgoingPeerID < ENET_PROTOCOL_MAXIMUM_PEER_ID ? currentPeer->connectID : 0;
                     host->buffers->dataLength += sizeof(enet_uint32);
                     *checksum = host->checksum(host->buffers, host->bufferCount);
                 }
 
                 if (shouldCompress > 0) {
-                    host->buffers[1].data       = host->packetData[1];
+                    host->buffers[1].data       = datagram->compressedData;
                     host->buffers[1].dataLength = shouldCompress;
                     host->bufferCount = 2;
                 }
 
                 currentPeer->lastSendTime = host->serviceTime;
-                sentLength = enet_socket_send(host->socket, &currentPeer->address, host->buffers, host->bufferCount);
-                enet_protocol_remove_sent_unreliable_commands(currentPeer);
 
-                if (sentLength < 0) {
+                // unreliable commands stay in sentUnreliableCommands until the datagram is flushed
+                datagram->peer        = currentPeer;
+                datagram->address     = currentPeer->address;
+                datagram->bufferCount = host->bufferCount;
+
+                enet_peer_schedule_timer(currentPeer);
+
+                if (++host->sendBatchCount >= ENET_HOST_SEND_BATCH && enet_protocol_flush_datagrams(host) < 0) {
                     return -1;
                 }
-
-                host->totalSentData += sentLength;
-                currentPeer->totalDataSent += sentLength;
-                host->totalSentPackets++;
             }
 
-        return 0;
+        return enet_protocol_flush_datagrams(host);
     } /* enet_protocol_send_outgoing_commands */
 
+    /** Takes the host's serviceTime from the clock. With ENET_HOST_CLOCK_MICROSECONDS both readings come
+     *  from one microsecond clock read, so the rest of the service works with a cached timestamp.
+     */
+    static void enet_host_update_time(ENetHost *host) {
+        if (host->clockMode == ENET_HOST_CLOCK_MICROSECONDS) {
+            host->serviceTimeMicroseconds = enet_time_get_us();
+            host->serviceTime             = (enet_uint32) (host->serviceTimeMicroseconds / 1000);
+        } else {
+            host->serviceTime = enet_time_get();
+        }
+    }
+
+    /** Moves the sends other threads posted with enet_peer_post onto their peers, in the order they were posted.
+     *  @returns the number of sends taken off the host
+     */
+    static size_t enet_host_take_posted_sends(ENetHost *host, int send) {
+        ENetPostedSend *postedSend, *next, *ordered = NULL;
+        size_t count = 0;
+
+        if ((ENetPostedSend *) ENET_ATOMIC_READ(&host->postedSends) == NULL) {
+            return 0;
+        }
+
+        // producers only ever push, so the whole stack can be taken without ABA trouble
+        do {
+            postedSend = (ENetPostedSend *) ENET_ATOMIC_READ(&host->postedSends);
+        } while ((ENetPostedSend *) ENET_ATOMIC_CAS(&host->postedSends, postedSend, NULL) != postedSend);
+
+        for (; postedSend != NULL; postedSend = next) {
+            next = postedSend->next;
+            postedSend->next = ordered;
+            ordered = postedSend;
+        }
+
+        for (postedSend = ordered; postedSend != NULL; postedSend = next) {
+            next = postedSend->next;
+
+            if ((!send || enet_peer_send(postedSend->peer, postedSend->channelID, postedSend->packet) < 0) &&
+                postedSend->packet->referenceCount == 0
+            ) {
+                callbacks.packet_destroy(postedSend->packet);
+            }
+
+            enet_free(postedSend);
+            ++count;
+        }
+
+        return count;
+    }
+
     /** Sends any queued packets on the host specified to its designated peers.
      *
      *  @param host   host to flush
@@ -3194,7 +4541,8 @@ extern "C" {
      *  @ingroup host
      */
     void enet_host_flush(ENetHost *host) {
-        host->serviceTime = enet_time_get();
+        enet_host_update_time(host);
+        enet_host_take_posted_sends(host, 1);
         enet_protocol_send_outgoing_commands(host, NULL, 0);
     }
 
@@ -3217,6 +4565,122 @@ extern "C" {
         return enet_protocol_dispatch_incoming_commands(host, event);
     }
 
+    static void enet_host_group_drain(ENetHostGroup *group) {
+    #ifdef ENET_USE_EPOLL
+        eventfd_t value;
+        eventfd_read(group->wakeEvent, &value);
+    #else
+        enet_uint8 data[16];
+        ENetBuffer buffer;
+
+        buffer.data       = data;
+        buffer.dataLength = sizeof(data);
+
+        while (enet_socket_receive(group->wakeSocket, NULL, &buffer, 1) > 0) {}
+    #endif
+    }
+
+    /** The descriptor that becomes readable when the host has datagrams: the io_uring instance when the
+     *  host uses it, since posted receives take datagrams off the socket before it ever looks readable.
+     */
+    static ENetSocket enet_host_descriptor(ENetHost *host) {
+    #ifdef ENET_USE_IO_URING
+        if (host->uring != NULL) {
+            return enet_uring_descriptor(host);
+        }
+    #endif
+
+        return host->socket;
+    }
+
+    /** Whether received datagrams are already waiting in user space, so waiting on the kernel would stall them. */
+    static int enet_host_receive_pending(ENetHost *host) {
+        if (host->receiveBatchIndex < host->receiveBatchCount) {
+            return 1;
+        }
+
+    #ifdef ENET_USE_IO_URING
+        if (host->uring != NULL) {
+            return enet_uring_pending(host);
+        }
+    #endif
+
+        return 0;
+    }
+
+    /** Waits on the host's socket and, when it belongs to a group, the group's wake as well.
+     *  Works like enet_socket_wait and adds ENET_SOCKET_WAIT_WAKE to the condition if the group was woken.
+     */
+    static int enet_host_wait(ENetHost *host, enet_uint32 *condition, enet_uint32 timeout) {
+        ENetHostGroup *group = host->group;
+
+        if (group == NULL) {
+            return enet_socket_wait(enet_host_descriptor(host), condition, timeout);
+        }
+
+        {
+        #ifdef ENET_USE_EPOLL
+            struct pollfd pollSockets[2];
+            int pollCount;
+
+            pollSockets[0].fd      = enet_host_descriptor(host);
+            pollSockets[0].events  = POLLIN;
+            pollSockets[0].revents = 0;
+            pollSockets[1].fd      = group->wakeEvent;
+            pollSockets[1].events  = POLLIN;
+            pollSockets[1].revents = 0;
+
+            pollCount = poll(pollSockets, 2, (int) timeout);
+
+            if (pollCount < 0) {
+                if (errno == EINTR && *condition & ENET_SOCKET_WAIT_INTERRUPT) {
+                    *condition = ENET_SOCKET_WAIT_INTERRUPT;
+                    return 0;
+                }
+
+                return -1;
+            }
+
+            *condition = ENET_SOCKET_WAIT_NONE;
+
+            if (pollSockets[0].revents & POLLIN) {
+                *condition |= ENET_SOCKET_WAIT_RECEIVE;
+            }
+
+            if (pollSockets[1].revents & POLLIN) {
+                enet_host_group_drain(group);
+                *condition |= ENET_SOCKET_WAIT_WAKE;
+            }
+        #else
+            ENetSocketSet readSet;
+            int selectCount;
+
+            ENET_SOCKETSET_EMPTY(readSet);
+            ENET_SOCKETSET_ADD(readSet, enet_host_descriptor(host));
+            ENET_SOCKETSET_ADD(readSet, group->wakeSocket);
+
+            selectCount = enet_socketset_select(ENET_MAX(enet_host_descriptor(host), group->wakeSocket), &readSet, NULL, timeout);
+
+            if (selectCount < 0) {
+                return -1;
+            }
+
+            *condition = ENET_SOCKET_WAIT_NONE;
+
+            if (ENET_SOCKETSET_CHECK(readSet, enet_host_descriptor(host))) {
+                *condition |= ENET_SOCKET_WAIT_RECEIVE;
+            }
+
+            if (ENET_SOCKETSET_CHECK(readSet, group->wakeSocket)) {
+                enet_host_group_drain(group);
+                *condition |= ENET_SOCKET_WAIT_WAKE;
+            }
+        #endif
+        }
+
+        return 0;
+    } /* enet_host_wait */
+
     /** Waits for events on the host specified and shuttles packets between
      *  the host and its peers.
      *
@@ -3231,7 +4695,8 @@ extern "C" {
      *  @ingroup host
      */
     int enet_host_service(ENetHost *host, ENetEvent *event, enet_uint32 timeout) {
-        enet_uint32 waitCondition;
+        enet_uint32 waitCondition, waitTime, timerDeadline;
+        int timerDue;
 
         if (event != NULL) {
             event->type   = ENET_EVENT_TYPE_NONE;
@@ -3254,7 +4719,7 @@ extern "C" {
             }
         }
 
-        host->serviceTime = enet_time_get();
+        enet_host_update_time(host);
         timeout += host->serviceTime;
 
         do {
@@ -3262,6 +4727,8 @@ extern "C" {
                 enet_host_bandwidth_throttle(host);
             }
 
+            enet_host_take_posted_sends(host, 1);
+
             switch (enet_protocol_send_outgoing_commands(host, event, 1)) {
                 case 1:
                     return 1;
@@ -3328,21 +4795,47 @@ extern "C" {
                 return 0;
             }
 
+            // datagrams still queued from the last batch are ready now, don't block on the socket for them
+            if (enet_host_receive_pending(host)) {
+                enet_host_update_time(host);
+                waitCondition     = ENET_SOCKET_WAIT_RECEIVE;
+                continue;
+            }
+
             do {
-                host->serviceTime = enet_time_get();
+                enet_host_update_time(host);
 
                 if (ENET_TIME_GREATER_EQUAL(host->serviceTime, timeout)) {
                     return 0;
                 }
 
+                // sleep until the first timer if it comes before the timeout, not past it
+                waitTime = ENET_TIME_DIFFERENCE(timeout, host->serviceTime);
+                timerDue = 0;
+
+                if (enet_host_next_timer(host, &timerDeadline) && ENET_TIME_LESS(timerDeadline, timeout)) {
+                    waitTime = ENET_TIME_GREATER(timerDeadline, host->serviceTime) ? timerDeadline - host->serviceTime : 0;
+                    timerDue = 1;
+                }
+
                 waitCondition = ENET_SOCKET_WAIT_RECEIVE | ENET_SOCKET_WAIT_INTERRUPT;
-                if (enet_socket_wait(host->socket, &waitCondition, ENET_TIME_DIFFERENCE(timeout, host->serviceTime)) != 0) {
+                if (enet_host_wait(host, &waitCondition, waitTime) != 0) {
                     return -1;
                 }
             } while (waitCondition & ENET_SOCKET_WAIT_INTERRUPT);
 
-            host->serviceTime = enet_time_get();
-        } while (waitCondition & ENET_SOCKET_WAIT_RECEIVE);
+            // another thread woke the group, send what it posted and hand control back so the caller can queue its work
+            if (waitCondition & ENET_SOCKET_WAIT_WAKE) {
+                if (enet_host_take_posted_sends(host, 1) > 0) {
+                    enet_host_update_time(host);
+                    enet_protocol_send_outgoing_commands(host, NULL, 0);
+                }
+
+                return 0;
+            }
+
+            enet_host_update_time(host);
+        } while ((waitCondition & ENET_SOCKET_WAIT_RECEIVE) || timerDue);
 
         return 0;
     } /* enet_host_service */
@@ -3461,6 +4954,10 @@ extern "C" {
         return host->mtu;
     }
 
+    ENetHostTransport enet_host_get_transport(ENetHost *host) {
+        return host->uring != NULL ? ENET_HOST_TRANSPORT_URING : ENET_HOST_TRANSPORT_SOCKET;
+    }
+
     enet_uint32 enet_peer_get_id(ENetPeer *peer) {
         return peer->connectID;
     }
@@ -3481,6 +4978,10 @@ extern "C" {
         return peer->roundTripTime;
     }
 
+    enet_uint32 enet_peer_get_rtt_us(ENetPeer *peer) {
+        return peer->host->clockMode == ENET_HOST_CLOCK_MICROSECONDS ? peer->roundTripTimeMicroseconds : peer->roundTripTime * 1000;
+    }
+
     enet_uint64 enet_peer_get_packets_sent(ENetPeer *peer) {
         return peer->totalPacketsSent;
     }
@@ -3517,6 +5018,44 @@ extern "C" {
         packet->freeCallback = (ENetPacketFreeCallback)callback;
     }
 
+    /** Queues a packet to be sent from a thread other than the one servicing the peer's host.
+     *  @param peer destination for the packet
+     *  @param channelID channel on which to send
+     *  @param packet packet to send, which the calling thread must not touch again
+     *  @param wake if non-zero and the host is in a group, wakes the group so the packet goes out right away
+     *  @retval 0 on success
+     *  @retval < 0 on failure
+     *  @remarks The packet is put on a lock free list of the host and handed to enet_peer_send by the next
+     *  enet_host_service or enet_host_flush, in the order each thread posted. Any number of threads can post
+     *  at once without blocking each other or the servicing thread. A packet the peer can't take by then, for
+     *  example because it has disconnected, is destroyed. Stop posting to a peer once its disconnect has been
+     *  handled, its slot can be reused for a new connection.
+     */
+    int enet_peer_post(ENetPeer *peer, enet_uint8 channelID, ENetPacket *packet, int wake) {
+        ENetHost *host = peer->host;
+        ENetPostedSend *postedSend = (ENetPostedSend *) enet_malloc(sizeof(ENetPostedSend));
+        ENetPostedSend *head;
+
+        if (postedSend == NULL) {
+            return -1;
+        }
+
+        postedSend->peer      = peer;
+        postedSend->packet    = packet;
+        postedSend->channelID = channelID;
+
+        do {
+            head = (ENetPostedSend *) ENET_ATOMIC_READ(&host->postedSends);
+            postedSend->next = head;
+        } while ((ENetPostedSend *) ENET_ATOMIC_CAS(&host->postedSends, head, postedSend) != head);
+
+        if (wake && host->group != NULL) {
+            enet_host_group_wake(host->group);
+        }
+
+        return 0;
+    }
+
     /** Queues a packet to be sent.
      *  @param peer destination for the packet
      *  @param channelID channel on which to send
@@ -3628,6 +5167,20 @@ extern "C" {
         return 0;
     } // enet_peer_send
 
+    /** Frees an incoming command and its fragment bitmap, leaving the packet to the caller. */
+    static void enet_peer_free_incoming_command(ENetIncomingCommand *incomingCommand) {
+        if (incomingCommand->fragmentCount > 0) {
+            enet_list_remove(&incomingCommand->fragmentList);
+        }
+
+        // a packet reassembled in a pooled buffer carries the bitmap behind its data
+        if (incomingCommand->fragments != NULL && !(incomingCommand->packet->flags & ENET_PACKET_FLAG_RECEIVE_VIEW)) {
+            enet_free(incomingCommand->fragments);
+        }
+
+        enet_free(incomingCommand);
+    }
+
     /** Attempts to dequeue any incoming queued packet.
      *  @param peer peer to dequeue packets from
      *  @param channelID holds the channel ID of the channel the packet was received on success
@@ -3650,11 +5203,7 @@ extern "C" {
         packet = incomingCommand->packet;
         --packet->referenceCount;
 
-        if (incomingCommand->fragments != NULL) {
-            enet_free(incomingCommand->fragments);
-        }
-
-        enet_free(incomingCommand);
+        enet_peer_free_incoming_command(incomingCommand);
         peer->totalWaitingData -= packet->dataLength;
 
         return packet;
@@ -3685,23 +5234,21 @@ extern "C" {
 
         for (currentCommand = startCommand; currentCommand != endCommand;) {
             ENetIncomingCommand *incomingCommand = (ENetIncomingCommand *) currentCommand;
+            ENetPacket *packet = incomingCommand->packet;
 
             currentCommand = enet_list_next(currentCommand);
             enet_list_remove(&incomingCommand->incomingCommandList);
 
-            if (incomingCommand->packet != NULL) {
-                --incomingCommand->packet->referenceCount;
+            // a pooled fragment bitmap lives in the packet's buffer, so the command goes before the packet
+            enet_peer_free_incoming_command(incomingCommand);
 
-                if (incomingCommand->packet->referenceCount == 0) {
-                    callbacks.packet_destroy(incomingCommand->packet);
-                }
-            }
+            if (packet != NULL) {
+                --packet->referenceCount;
 
-            if (incomingCommand->fragments != NULL) {
-                enet_free(incomingCommand->fragments);
+                if (packet->referenceCount == 0) {
+                    callbacks.packet_destroy(packet);
+                }
             }
-
-            enet_free(incomingCommand);
         }
     }
 
@@ -3717,6 +5264,13 @@ extern "C" {
             peer->needsDispatch = 0;
         }
 
+        if (peer->needsSend) {
+            enet_list_remove(&peer->sendList);
+            peer->needsSend = 0;
+        }
+
+        enet_peer_unschedule_timer(peer);
+
         while (!enet_list_empty(&peer->acknowledgements)) {
             enet_free(enet_list_remove(enet_list_begin(&peer->acknowledgements)));
         }
@@ -3747,6 +5301,7 @@ extern "C" {
             }
 
             ++peer->host->connectedPeers;
+            enet_list_insert(enet_list_end(&peer->host->connectedPeerList), &peer->connectedList);
         }
     }
 
@@ -3757,6 +5312,7 @@ extern "C" {
             }
 
             --peer->host->connectedPeers;
+            enet_list_remove(&peer->connectedList);
         }
     }
 
@@ -3768,6 +5324,10 @@ extern "C" {
     void enet_peer_reset(ENetPeer *peer) {
         enet_peer_on_disconnect(peer);
 
+        if (peer->state != ENET_PEER_STATE_DISCONNECTED) {
+            enet_host_release_peer(peer->host, peer);
+        }
+
         // We don't want to reset connectID here, otherwise, we can't get it in the Disconnect event
         // peer->connectID                     = 0;
         peer->outgoingPeerID                = ENET_PROTOCOL_MAXIMUM_PEER_ID;
@@ -3808,10 +5368,15 @@ extern "C" {
         peer->highestRoundTripTimeVariance  = 0;
         peer->roundTripTime                 = ENET_PEER_DEFAULT_ROUND_TRIP_TIME;
         peer->roundTripTimeVariance         = 0;
+        peer->roundTripTimeMicroseconds     = ENET_PEER_DEFAULT_ROUND_TRIP_TIME * 1000;
+        peer->roundTripTimeVarianceMicroseconds = 0;
         peer->mtu                           = peer->host->mtu;
         peer->reliableDataInTransit         = 0;
+        peer->pacingCredit                  = 0;
+        peer->pacingTime                    = 0;
         peer->outgoingReliableSequenceNumber = 0;
         peer->windowSize                    = ENET_PROTOCOL_MAXIMUM_WINDOW_SIZE;
+        peer->acknowledgeBitfield           = 0;
         peer->incomingUnsequencedGroup      = 0;
         peer->outgoingUnsequencedGroup      = 0;
         peer->eventData                     = 0;
@@ -3819,6 +5384,10 @@ extern "C" {
 
         memset(peer->unsequencedWindow, 0, sizeof(peer->unsequencedWindow));
         enet_peer_reset_queues(peer);
+
+        if (peer->host->congestionControl.context != NULL && peer->host->congestionControl.reset != NULL) {
+            peer->host->congestionControl.reset(peer->host->congestionControl.context, peer);
+        }
     }
 
     /** Sends a ping request to a peer.
@@ -3965,6 +5534,14 @@ extern "C" {
         }
     }
 
+    /** Puts a peer on its host's send queue so the next enet_host_service builds a datagram for it. */
+    void enet_peer_queue_send(ENetPeer *peer) {
+        if (!peer->needsSend) {
+            enet_list_insert(enet_list_end(&peer->host->sendQueue), &peer->sendList);
+            peer->needsSend = 1;
+        }
+    }
+
     ENetAcknowledgement *enet_peer_queue_acknowledgement(ENetPeer *peer, const ENetProtocol *command, enet_uint16 sentTime) {
         ENetAcknowledgement *acknowledgement;
 
@@ -3993,6 +5570,7 @@ extern "C" {
         acknowledgement->command  = *command;
 
         enet_list_insert(enet_list_end(&peer->acknowledgements), acknowledgement);
+        enet_peer_queue_send(peer);
         return acknowledgement;
     }
 
@@ -4052,6 +5630,8 @@ extern "C" {
         } else {
             enet_list_insert(enet_list_end(&peer->outgoingUnreliableCommands), outgoingCommand);
         }
+
+        enet_peer_queue_send(peer);
     }
 
     ENetOutgoingCommand * enet_peer_queue_outgoing_command(ENetPeer *peer, const ENetProtocol *command, ENetPacket *packet, enet_uint32 offset, enet_uint16 length) {
@@ -4191,6 +5771,7 @@ extern "C" {
         ENetIncomingCommand *incomingCommand;
         ENetListIterator currentCommand;
         ENetPacket *packet = NULL;
+        enet_uint32 *fragments = NULL;
 
         if (peer->state == ENET_PEER_STATE_DISCONNECT_LATER) {
             goto discardCommand;
@@ -4297,7 +5878,18 @@ extern "C" {
             goto notifyError;
         }
 
-        packet = callbacks.packet_create(data, dataLength, flags);
+        // a whole packet from the datagram being handled can point into its receive buffer instead of being copied
+        if (fragmentCount > 0 && fragmentCount <= ENET_PROTOCOL_MAXIMUM_FRAGMENT_COUNT) {
+            packet = enet_host_reassembly_packet(peer->host, dataLength, flags, fragmentCount, &fragments);
+        } else if (fragmentCount == 0 && data != NULL && peer->host->receivedBuffer != NULL &&
+            (const enet_uint8 *) data >= peer->host->receivedBuffer->data &&
+            (const enet_uint8 *) data + dataLength <= peer->host->receivedBuffer->data + peer->host->receivePool->bufferSize
+        ) {
+            packet = enet_receive_view_create(peer->host->receivedBuffer, data, dataLength, flags);
+        } else {
+            packet = callbacks.packet_create(data, dataLength, flags);
+        }
+
         if (packet == NULL) {
             goto notifyError;
         }
@@ -4316,17 +5908,24 @@ extern "C" {
         incomingCommand->fragments                  = NULL;
 
         if (fragmentCount > 0) {
-            if (fragmentCount <= ENET_PROTOCOL_MAXIMUM_FRAGMENT_COUNT) {
-                incomingCommand->fragments = (enet_uint32 *) enet_malloc((fragmentCount + 31) / 32 * sizeof(enet_uint32));
+            if (fragments == NULL && fragmentCount <= ENET_PROTOCOL_MAXIMUM_FRAGMENT_COUNT) {
+                fragments = (enet_uint32 *) enet_malloc((fragmentCount + 31) / 32 * sizeof(enet_uint32));
             }
 
-            if (incomingCommand->fragments == NULL) {
+            if (fragments == NULL) {
                 enet_free(incomingCommand);
 
                 goto notifyError;
             }
 
-            memset(incomingCommand->fragments, 0, (fragmentCount + 31) / 32 * sizeof(enet_uint32));
+            memset(fragments, 0, (fragmentCount + 31) / 32 * sizeof(enet_uint32));
+            incomingCommand->fragments = fragments;
+
+            // the remaining fragments find the command through the peer's fragment table instead of scanning the channel
+            enet_list_insert(enet_list_end(enet_peer_fragment_bucket(peer, command->header.channelID,
+                (command->header.command & ENET_PROTOCOL_COMMAND_MASK) == ENET_PROTOCOL_COMMAND_SEND_FRAGMENT ?
+                    incomingCommand->reliableSequenceNumber : incomingCommand->unreliableSequenceNumber
+            )), &incomingCommand->fragmentList);
         }
 
         if (packet != NULL) {
@@ -4390,8 +5989,21 @@ extern "C" {
      *  at any given time.
      */
     ENetHost * enet_host_create(const ENetAddress *address, size_t peerCount, size_t channelLimit, enet_uint32 incomingBandwidth, enet_uint32 outgoingBandwidth) {
+        return enet_host_create_transport(address, peerCount, channelLimit, incomingBandwidth, outgoingBandwidth, ENET_HOST_TRANSPORT_SOCKET);
+    }
+
+    /** Creates a host like enet_host_create, moving its datagrams with the given transport.
+     *
+     *  @param transport ENET_HOST_TRANSPORT_URING keeps a ring of receives posted with io_uring and submits each
+     *  send batch with one system call, which suits servers handling many packets per second. It is only
+     *  available on Linux 5.4 or newer; anywhere else the host falls back to ENET_HOST_TRANSPORT_SOCKET.
+     *
+     *  @returns the host on success and NULL on failure, check enet_host_get_transport for the transport it ended up with
+     */
+    ENetHost * enet_host_create_transport(const ENetAddress *address, size_t peerCount, size_t channelLimit, enet_uint32 incomingBandwidth, enet_uint32 outgoingBandwidth, ENetHostTransport transport) {
         ENetHost *host;
         ENetPeer *currentPeer;
+        size_t bucket, slot;
 
         if (peerCount > ENET_PROTOCOL_MAXIMUM_PEER_ID) {
             return NULL;
@@ -4409,16 +6021,51 @@ extern "C" {
 
         memset(host->peers, 0, peerCount * sizeof(ENetPeer));
 
-        host->socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
-        if (host->socket != ENET_SOCKET_NULL) {
-            enet_socket_set_option (host->socket, ENET_SOCKOPT_IPV6_V6ONLY, 0);
+        // one address bucket per peer, rounded up to a power of two
+        host->peerAddressMask = 1;
+        while (host->peerAddressMask < peerCount) {
+            host->peerAddressMask <<= 1;
         }
 
-        if (host->socket == ENET_SOCKET_NULL || (address != NULL && enet_socket_bind(host->socket, address) < 0)) {
-            if (host->socket != ENET_SOCKET_NULL) {
-                enet_socket_destroy(host->socket);
-            }
+        host->peerAddresses = (ENetList *) enet_malloc(host->peerAddressMask * sizeof(ENetList));
+        if (host->peerAddresses == NULL) {
+            enet_free(host->peers);
+            enet_free(host);
+            return NULL;
+        }
+
+        for (bucket = 0; bucket < host->peerAddressMask; ++bucket) {
+            enet_list_clear(&host->peerAddresses[bucket]);
+        }
+
+        host->peerAddressMask -= 1;
+
+        host->receiveBufferCount = ENET_HOST_RECEIVE_BATCH;
+        host->receiveBufferSize  = ENET_PROTOCOL_MAXIMUM_MTU;
+        host->receiveBuffers     = (enet_uint8 *) enet_malloc(host->receiveBufferCount * host->receiveBufferSize);
+        host->sendBatch      = (ENetDatagram *) enet_malloc(ENET_HOST_SEND_BATCH * sizeof(ENetDatagram));
+        if (host->receiveBuffers == NULL || host->sendBatch == NULL) {
+            enet_free(host->receiveBuffers);
+            enet_free(host->sendBatch);
+            enet_free(host->peerAddresses);
+            enet_free(host->peers);
+            enet_free(host);
+            return NULL;
+        }
+
+        host->socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+        if (host->socket != ENET_SOCKET_NULL) {
+            enet_socket_set_option (host->socket, ENET_SOCKOPT_IPV6_V6ONLY, 0);
+        }
+
+        if (host->socket == ENET_SOCKET_NULL || (address != NULL && enet_socket_bind(host->socket, address) < 0)) {
+            if (host->socket != ENET_SOCKET_NULL) {
+                enet_socket_destroy(host->socket);
+            }
 
+            enet_free(host->receiveBuffers);
+            enet_free(host->sendBatch);
+            enet_free(host->peerAddresses);
             enet_free(host->peers);
             enet_free(host);
 
@@ -4451,13 +6098,27 @@ extern "C" {
         host->recalculateBandwidthLimits    = 0;
         host->mtu                           = ENET_HOST_DEFAULT_MTU;
         host->peerCount                     = peerCount;
+        host->commands                      = host->sendBatch[0].commands;
         host->commandCount                  = 0;
+        host->buffers                       = host->sendBatch[0].buffers;
         host->bufferCount                   = 0;
+        host->sendBatchCount                = 0;
         host->checksum                      = NULL;
         host->receivedAddress.host          = ENET_HOST_ANY;
         host->receivedAddress.port          = 0;
         host->receivedData                  = NULL;
         host->receivedDataLength            = 0;
+        host->receiveBatchCount             = 0;
+        host->receiveBatchIndex             = 0;
+        host->receiveBatchOffset            = 0;
+        host->receivePool                   = NULL;
+        host->decompressBuffer              = NULL;
+        host->receivedBuffer                = NULL;
+        host->offload                       = 0;
+        host->clockMode                     = ENET_HOST_CLOCK_MILLISECONDS;
+        host->serviceTimeMicroseconds       = 0;
+        host->group                         = NULL;
+        host->uring                         = NULL;
         host->totalSentData                 = 0;
         host->totalSentPackets              = 0;
         host->totalReceivedData             = 0;
@@ -4471,9 +6132,39 @@ extern "C" {
         host->compressor.compress           = NULL;
         host->compressor.decompress         = NULL;
         host->compressor.destroy            = NULL;
+        host->congestionControl.context     = NULL;
+        host->congestionControl.destroy     = NULL;
+        host->postedSends                   = NULL;
         host->intercept                     = NULL;
+        host->sendIntercept                 = NULL;
+        host->interceptContext              = NULL;
 
         enet_list_clear(&host->dispatchQueue);
+        enet_list_clear(&host->freePeers);
+        enet_list_clear(&host->connectedPeerList);
+        enet_list_clear(&host->sendQueue);
+
+        for (slot = 0; slot < ENET_TIMER_WHEEL_SLOTS; ++slot) {
+            enet_list_clear(&host->timerSlots[slot]);
+        }
+
+        for (slot = 0; slot < ENET_TIMER_LEVELS * ENET_TIMER_LEVEL_SLOTS; ++slot) {
+            enet_list_clear(&host->timerLevels[slot / ENET_TIMER_LEVEL_SLOTS][slot % ENET_TIMER_LEVEL_SLOTS]);
+        }
+
+        host->timerTime = enet_time_get();
+
+        // segmentation only changes how datagrams are handed to the kernel, so use it wherever it is available
+        enet_host_offload(host, ENET_HOST_OFFLOAD_SEGMENT);
+
+    #ifdef ENET_USE_IO_URING
+        // io_uring sends every datagram as its own message, the socket offloads don't apply to it
+        if (transport == ENET_HOST_TRANSPORT_URING && enet_uring_create(host) == 0) {
+            host->offload = 0;
+        }
+    #else
+        ENET_UNUSED(transport)
+    #endif
 
         for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
             currentPeer->host = host;
@@ -4488,22 +6179,43 @@ extern "C" {
             enet_list_clear(&currentPeer->outgoingUnreliableCommands);
             enet_list_clear(&currentPeer->dispatchedCommands);
 
+            for (bucket = 0; bucket < ENET_PEER_FRAGMENT_BUCKETS; ++bucket) {
+                enet_list_clear(&currentPeer->fragmentBuckets[bucket]);
+            }
+
             enet_peer_reset(currentPeer);
+
+            // every peer starts out free, handed out in order
+            enet_list_insert(enet_list_end(&host->freePeers), &currentPeer->freeList);
         }
 
         return host;
-    } /* enet_host_create */
+    } /* enet_host_create_transport */
 
     /** Destroys the host and all resources associated with it.
      *  @param host pointer to the host to destroy
      */
     void enet_host_destroy(ENetHost *host) {
         ENetPeer *currentPeer;
+        size_t sizeClass;
 
         if (host == NULL) {
             return;
         }
 
+        if (host->group != NULL) {
+            enet_host_group_remove(host->group, host);
+        }
+
+        // sends posted after the last service never reach their peers
+        enet_host_take_posted_sends(host, 0);
+
+    #ifdef ENET_USE_IO_URING
+        if (host->uring != NULL) {
+            enet_uring_destroy(host);
+        }
+    #endif
+
         enet_socket_destroy(host->socket);
 
         for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
@@ -4514,6 +6226,24 @@ extern "C" {
             (*host->compressor.destroy)(host->compressor.context);
         }
 
+        if (host->congestionControl.context != NULL && host->congestionControl.destroy) {
+            (*host->congestionControl.destroy)(host->congestionControl.context);
+        }
+
+        // datagrams still waiting in the ring go with the host, packets the application still holds keep
+        // their buffers and the pool until they are destroyed
+        host->receiveBatchIndex = host->receiveBatchCount;
+        enet_host_zero_copy(host, 0);
+
+        for (sizeClass = 0; sizeClass < ENET_HOST_REASSEMBLY_CLASSES; ++sizeClass) {
+            if (host->reassemblyPools[sizeClass] != NULL) {
+                enet_receive_pool_detach(host->reassemblyPools[sizeClass]);
+            }
+        }
+
+        enet_free(host->receiveBuffers);
+        enet_free(host->sendBatch);
+        enet_free(host->peerAddresses);
         enet_free(host->peers);
         enet_free(host);
     }
@@ -4538,16 +6268,12 @@ extern "C" {
             channelCount = ENET_PROTOCOL_MAXIMUM_CHANNEL_COUNT;
         }
 
-        for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
-            if (currentPeer->state == ENET_PEER_STATE_DISCONNECTED) {
-                break;
-            }
-        }
-
-        if (currentPeer >= &host->peers[host->peerCount]) {
+        if (enet_list_empty(&host->freePeers)) {
             return NULL;
         }
 
+        currentPeer = enet_list_peer(enet_list_front(&host->freePeers), freeList);
+
         currentPeer->channels = (ENetChannel *) enet_malloc(channelCount * sizeof(ENetChannel));
         if (currentPeer->channels == NULL) {
             return NULL;
@@ -4557,6 +6283,7 @@ extern "C" {
         currentPeer->state        = ENET_PEER_STATE_CONNECTING;
         currentPeer->address      = *address;
         currentPeer->connectID    = ++host->randomSeed;
+        enet_host_claim_peer(host, currentPeer);
 
         if (host->outgoingBandwidth == 0) {
             currentPeer->windowSize = ENET_PROTOCOL_MAXIMUM_WINDOW_SIZE;
@@ -4583,7 +6310,7 @@ extern "C" {
             memset(channel->reliableWindows, 0, sizeof(channel->reliableWindows));
         }
 
-        command.header.command                     = ENET_PROTOCOL_COMMAND_CONNECT | ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE;
+        command.header.command                     = ENET_PROTOCOL_COMMAND_CONNECT | ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE | ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE_BITFIELD;
         command.header.channelID                   = 0xFF;
         command.connect.outgoingPeerID             = ENET_HOST_TO_NET_16(currentPeer->incomingPeerID);
         command.connect.incomingSessionID          = currentPeer->incomingSessionID;
@@ -4611,8 +6338,11 @@ extern "C" {
      */
     void enet_host_broadcast(ENetHost *host, enet_uint8 channelID, ENetPacket *packet) {
         ENetPeer *currentPeer;
+        ENetListIterator currentNode;
+
+        for (currentNode = enet_list_begin(&host->connectedPeerList); currentNode != enet_list_end(&host->connectedPeerList); currentNode = enet_list_next(currentNode)) {
+            currentPeer = enet_list_peer(currentNode, connectedList);
 
-        for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
             if (currentPeer->state != ENET_PEER_STATE_CONNECTED) {
                 continue;
             }
@@ -4667,6 +6397,16 @@ extern "C" {
         host->intercept = callback;
     }
 
+    /** Sets the callback that sees every datagram before the host sends it.
+     *  @param host host to set a callback
+     *  @param callback send intercept callback, NULL to send straight to the socket again
+     *  @remarks While one is set the host sends its datagrams one at a time instead of in batches, so it is
+     *  meant for tests and tools, such as simulating network conditions.
+     */
+    void enet_host_set_send_intercept(ENetHost *host, const ENetSendInterceptCallback callback) {
+        host->sendIntercept = callback;
+    }
+
     /** Sets the packet compressor the host should use to compress and decompress packets.
      *  @param host host to enable or disable compression for
      *  @param compressor callbacks for for the packet compressor; if NULL, then compression is disabled
@@ -4683,6 +6423,308 @@ extern "C" {
         }
     }
 
+    /** Sets the congestion control the host uses for its peers.
+     *  @param host host to configure
+     *  @param congestionControl callbacks of the congestion control; if NULL, ENet's own throttle is used again
+     *  @remarks The congestion control is reset for every peer, including connected ones. While one is attached,
+     *  reliable sends are also paced over the peer's round trip time, and enet_peer_throttle is not called, so
+     *  packetThrottle (which decides how many unreliable packets are dropped) is only changed by the congestion
+     *  control and the bandwidth limits.
+     */
+    void enet_host_congestion_control(ENetHost *host, const ENetCongestionControl *congestionControl) {
+        ENetPeer *currentPeer;
+
+        if (host->congestionControl.context != NULL && host->congestionControl.destroy) {
+            (*host->congestionControl.destroy)(host->congestionControl.context);
+        }
+
+        if (congestionControl) {
+            host->congestionControl = *congestionControl;
+        } else {
+            host->congestionControl.context = NULL;
+        }
+
+        for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
+            currentPeer->pacingCredit = 0;
+            currentPeer->pacingTime   = host->serviceTime;
+
+            if (host->congestionControl.context != NULL && host->congestionControl.reset != NULL) {
+                host->congestionControl.reset(host->congestionControl.context, currentPeer);
+            }
+        }
+    }
+
+    typedef struct _ENetDelayControl {
+        enet_uint32 targetDelay;
+    } ENetDelayControl;
+
+    static void ENET_CALLBACK enet_delay_control_reset(void *context, ENetPeer *peer) {
+        ENET_UNUSED(context)
+
+        peer->congestionWindow = ENET_PEER_CONGESTION_INITIAL_WINDOW * peer->mtu;
+        peer->congestionEpoch  = 0;
+        peer->baseDelay        = ~0u;
+        peer->lastBaseDelay    = ~0u;
+        peer->baseDelayEpoch   = peer->host->serviceTime;
+    }
+
+    static void ENET_CALLBACK enet_delay_control_acknowledge(void *context, ENetPeer *peer, enet_uint32 roundTripTime, enet_uint32 acknowledgedLength) {
+        ENetDelayControl *control = (ENetDelayControl *) context;
+        enet_uint32 queuingDelay, offTarget;
+        enet_uint64 change;
+
+        if (ENET_TIME_DIFFERENCE(peer->host->serviceTime, peer->baseDelayEpoch) >= ENET_PEER_DELAY_BASE_INTERVAL) {
+            peer->lastBaseDelay  = peer->baseDelay;
+            peer->baseDelay      = roundTripTime;
+            peer->baseDelayEpoch = peer->host->serviceTime;
+        } else if (roundTripTime < peer->baseDelay) {
+            peer->baseDelay = roundTripTime;
+        }
+
+        // whatever the round trip takes above the lowest one seen lately is time spent waiting in queues
+        queuingDelay = roundTripTime - ENET_MIN(peer->baseDelay, peer->lastBaseDelay);
+
+        if (queuingDelay <= control->targetDelay) {
+            // grow in proportion to how far below the target the delay is, by at most what was acknowledged
+            offTarget = control->targetDelay - queuingDelay;
+            change    = (enet_uint64) offTarget * acknowledgedLength * peer->mtu / ((enet_uint64) control->targetDelay * peer->congestionWindow);
+
+            peer->congestionWindow += (enet_uint32) ENET_MIN(change, acknowledgedLength);
+            if (peer->congestionWindow > peer->windowSize) {
+                peer->congestionWindow = ENET_MAX(peer->windowSize, ENET_PEER_CONGESTION_MINIMUM_WINDOW * peer->mtu);
+            }
+
+            peer->packetThrottle += peer->packetThrottleAcceleration;
+            if (peer->packetThrottle > peer->packetThrottleLimit) {
+                peer->packetThrottle = peer->packetThrottleLimit;
+            }
+        } else {
+            // and shrink the same way above it, before any packet is lost
+            offTarget = ENET_MIN(queuingDelay - control->targetDelay, control->targetDelay);
+            change    = (enet_uint64) offTarget * acknowledgedLength * peer->mtu / ((enet_uint64) control->targetDelay * peer->congestionWindow);
+
+            if (peer->congestionWindow > ENET_PEER_CONGESTION_MINIMUM_WINDOW * peer->mtu + change) {
+                peer->congestionWindow -= (enet_uint32) change;
+            } else {
+                peer->congestionWindow = ENET_PEER_CONGESTION_MINIMUM_WINDOW * peer->mtu;
+            }
+
+            if (peer->packetThrottle > peer->packetThrottleDeceleration) {
+                peer->packetThrottle -= peer->packetThrottleDeceleration;
+            } else {
+                peer->packetThrottle = 0;
+            }
+        }
+    }
+
+    static void ENET_CALLBACK enet_delay_control_loss(void *context, ENetPeer *peer) {
+        ENET_UNUSED(context)
+
+        // a burst of timeouts is one loss event, back off at most once per round trip
+        if (peer->congestionEpoch != 0 && ENET_TIME_DIFFERENCE(peer->host->serviceTime, peer->congestionEpoch) < ENET_MAX(peer->roundTripTime, 1)) {
+            return;
+        }
+
+        peer->congestionWindow = ENET_MAX(peer->congestionWindow / 2, ENET_PEER_CONGESTION_MINIMUM_WINDOW * peer->mtu);
+        peer->congestionEpoch  = peer->host->serviceTime;
+    }
+
+    static enet_uint32 ENET_CALLBACK enet_delay_control_window(void *context, ENetPeer *peer) {
+        ENET_UNUSED(context)
+
+        return ENET_MIN(peer->congestionWindow, peer->windowSize);
+    }
+
+    static void ENET_CALLBACK enet_delay_control_destroy(void *context) {
+        enet_free(context);
+    }
+
+    /** Attaches ENet's delay based congestion control to the host, in the manner of LEDBAT.
+     *  @param host host to configure
+     *  @param targetDelay queuing delay, in microseconds, to aim for; 0 for ENET_PEER_DELAY_TARGET
+     *  @returns 0 on success, < 0 on failure
+     *  @remarks Each peer's lowest round trip time over the last 10 to 20 seconds is taken as the delay of the path
+     *  with empty queues, and anything above it as queuing. The window of reliable data grows while the queuing
+     *  delay is under the target and shrinks once it is over, so the peer backs off as a queue builds up instead
+     *  of after it overflows, and halves on a timeout. The same signal moves packetThrottle, which drops unreliable
+     *  packets while the link is queuing. Works best with ENET_HOST_CLOCK_MICROSECONDS, with millisecond round trip
+     *  times the target should be several milliseconds.
+     */
+    int enet_host_congestion_control_delay(ENetHost *host, enet_uint32 targetDelay) {
+        ENetCongestionControl congestionControl;
+        ENetDelayControl *control = (ENetDelayControl *) enet_malloc(sizeof(ENetDelayControl));
+
+        if (control == NULL) {
+            return -1;
+        }
+
+        control->targetDelay = targetDelay != 0 ? targetDelay : ENET_PEER_DELAY_TARGET;
+
+        congestionControl.context     = control;
+        congestionControl.reset       = enet_delay_control_reset;
+        congestionControl.acknowledge = enet_delay_control_acknowledge;
+        congestionControl.loss        = enet_delay_control_loss;
+        congestionControl.window      = enet_delay_control_window;
+        congestionControl.destroy     = enet_delay_control_destroy;
+        enet_host_congestion_control(host, &congestionControl);
+
+        return 0;
+    }
+
+    /** Turns kernel offloads on or off for the host.
+     *  @param host host to configure
+     *  @param offload ENET_HOST_OFFLOAD_* flags that should be in use
+     *  @returns the flags that are in use afterwards, an offload the platform does not support stays off
+     *  @remarks Segmentation is turned on by enet_host_create when it is available. Coalescing makes the
+     *  kernel join datagrams from one sender, which helps clients receiving large transfers, but it swaps
+     *  the receive ring for ENET_HOST_COALESCED_RECEIVE_BATCH buffers of 64KB, so a server receiving small
+     *  datagrams from many peers is better off without it. Coalescing can only change while no received
+     *  datagrams are waiting, so call this outside enet_host_service. Hosts using ENET_HOST_TRANSPORT_URING
+     *  have no offloads.
+     */
+    enet_uint32 enet_host_offload(ENetHost *host, enet_uint32 offload) {
+    #ifdef ENET_USE_IO_URING
+        if (host->uring != NULL) {
+            return host->offload;
+        }
+    #endif
+
+        if (offload & ENET_HOST_OFFLOAD_SEGMENT) {
+            if (enet_socket_set_option(host->socket, ENET_SOCKOPT_UDP_SEGMENT, 0) == 0) {
+                host->offload |= ENET_HOST_OFFLOAD_SEGMENT;
+            }
+        } else {
+            host->offload &= ~ENET_HOST_OFFLOAD_SEGMENT;
+        }
+
+        if ((offload & ENET_HOST_OFFLOAD_COALESCE) != (host->offload & ENET_HOST_OFFLOAD_COALESCE) &&
+            host->receiveBatchIndex >= host->receiveBatchCount
+        ) {
+            int coalesce             = (offload & ENET_HOST_OFFLOAD_COALESCE) != 0;
+            size_t bufferCount       = coalesce ? ENET_HOST_COALESCED_RECEIVE_BATCH : ENET_HOST_RECEIVE_BATCH;
+            size_t bufferSize        = coalesce ? ENET_HOST_COALESCED_RECEIVE_SIZE : ENET_PROTOCOL_MAXIMUM_MTU;
+            enet_uint8 *buffers      = (enet_uint8 *) enet_malloc(bufferCount * bufferSize);
+
+            if (buffers != NULL && enet_socket_set_option(host->socket, ENET_SOCKOPT_UDP_GRO, coalesce) == 0) {
+                enet_free(host->receiveBuffers);
+
+                host->receiveBuffers     = buffers;
+                host->receiveBufferCount = bufferCount;
+                host->receiveBufferSize  = bufferSize;
+                host->offload           ^= ENET_HOST_OFFLOAD_COALESCE;
+
+                // zero copy buffers have to match the new ring
+                if (host->receivePool != NULL) {
+                    enet_host_zero_copy(host, 0);
+                    enet_host_zero_copy(host, 1);
+                }
+            } else {
+                enet_free(buffers);
+            }
+        }
+
+        return host->offload;
+    }
+
+    /** Delivers packets that arrive whole in one datagram without copying them.
+     *  @param host host to configure
+     *  @param enable 1 to hand out packets that point into the buffer they were received in, 0 to copy them again
+     *  @returns 0 on success, -1 if the mode could not be changed
+     *  @remarks The receive ring and the buffer compressed datagrams expand into are taken from a pool of
+     *  refcounted buffers. Received packets carry ENET_PACKET_FLAG_RECEIVE_VIEW and keep their buffer in use
+     *  until enet_packet_destroy, the ring takes another buffer in its place. Fragmented packets are
+     *  reassembled in buffers from per size pools instead. The pools are not locked, so every received
+     *  packet has to be destroyed on the thread servicing the host while this is on. A packet held for long keeps a whole receive buffer alive, 64KB
+     *  with ENET_HOST_OFFLOAD_COALESCE, so copy out anything kept past the event. It needs the default
+     *  packet_create and packet_destroy callbacks and isn't available with ENET_HOST_TRANSPORT_URING, whose
+     *  buffers stay posted to the kernel. Like coalescing it can only change while no received datagrams are
+     *  waiting, so call this outside enet_host_service.
+     */
+    int enet_host_zero_copy(ENetHost *host, int enable) {
+        size_t i;
+
+        if (host->receiveBatchIndex < host->receiveBatchCount) {
+            return -1;
+        }
+
+        if (!enable) {
+            if (host->receivePool == NULL) {
+                return 0;
+            }
+
+            for (i = 0; i < ENET_HOST_RECEIVE_BATCH; ++i) {
+                if (host->receiveSlots[i] != NULL) {
+                    enet_receive_buffer_release(host->receiveSlots[i]);
+                    host->receiveSlots[i] = NULL;
+                }
+            }
+
+            if (host->decompressBuffer != NULL) {
+                enet_receive_buffer_release(host->decompressBuffer);
+                host->decompressBuffer = NULL;
+            }
+
+            enet_receive_pool_detach(host->receivePool);
+            host->receivePool    = NULL;
+            host->receivedBuffer = NULL;
+
+            return 0;
+        }
+
+        if (host->receivePool != NULL) {
+            return 0;
+        }
+
+        if (host->uring != NULL || callbacks.packet_create != enet_packet_create || callbacks.packet_destroy != enet_packet_destroy) {
+            return -1;
+        }
+
+        host->receivePool = enet_receive_pool_create(host->receiveBufferSize, ENET_HOST_RECEIVE_POOL_BUFFERS);
+        if (host->receivePool == NULL) {
+            return -1;
+        }
+
+        for (i = 0; i < host->receiveBufferCount; ++i) {
+            host->receiveSlots[i] = enet_receive_buffer_acquire(host->receivePool);
+            if (host->receiveSlots[i] == NULL) {
+                enet_host_zero_copy(host, 0);
+                return -1;
+            }
+        }
+
+        host->decompressBuffer = enet_receive_buffer_acquire(host->receivePool);
+        if (host->decompressBuffer == NULL) {
+            enet_host_zero_copy(host, 0);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    /** Picks how precisely the host measures round trip times.
+     *  @param host host to configure
+     *  @param clockMode ENET_HOST_CLOCK_MICROSECONDS to estimate round trip times and retransmission timeouts
+     *  in microseconds, which keeps them from collapsing to 0 or 1ms on a LAN
+     *  @remarks The protocol still echoes 16 bit millisecond send times, so peers using either mode work together.
+     *  Timers and timeouts keep firing on the millisecond wheel, only their deadlines get more precise. The
+     *  estimate of connected peers carries over when switching.
+     */
+    void enet_host_clock(ENetHost *host, ENetHostClock clockMode) {
+        ENetPeer *currentPeer;
+
+        if (clockMode == host->clockMode) {
+            return;
+        }
+
+        for (currentPeer = host->peers; currentPeer < &host->peers[host->peerCount]; ++currentPeer) {
+            currentPeer->roundTripTimeMicroseconds         = currentPeer->roundTripTime * 1000;
+            currentPeer->roundTripTimeVarianceMicroseconds = currentPeer->roundTripTimeVariance * 1000;
+        }
+
+        host->clockMode = clockMode;
+        enet_host_update_time(host);
+    }
+
     /** Limits the maximum allowed channels of future incoming connections.
      *  @param host host to limit
      *  @param channelLimit the maximum number of channels allowed; if 0, then this is equivalent to ENET_PROTOCOL_MAXIMUM_CHANNEL_COUNT
@@ -4721,6 +6763,7 @@ extern "C" {
 
         int needsAdjustment = host->bandwidthLimitedPeers > 0 ? 1 : 0;
         ENetPeer *peer;
+        ENetListIterator currentNode;
         ENetProtocol command;
 
         if (elapsedTime < ENET_HOST_BANDWIDTH_THROTTLE_INTERVAL) {
@@ -4741,11 +6784,8 @@ extern "C" {
             dataTotal = 0;
             bandwidth = (host->outgoingBandwidth * elapsedTime) / 1000;
 
-            for (peer = host->peers; peer < &host->peers[host->peerCount]; ++peer) {
-                if (peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER) {
-                    continue;
-                }
-
+            for (currentNode = enet_list_begin(&host->connectedPeerList); currentNode != enet_list_end(&host->connectedPeerList); currentNode = enet_list_next(currentNode)) {
+                peer = enet_list_peer(currentNode, connectedList);
                 dataTotal += peer->outgoingDataTotal;
             }
         }
@@ -4759,13 +6799,11 @@ extern "C" {
                 throttle = (bandwidth * ENET_PEER_PACKET_THROTTLE_SCALE) / dataTotal;
             }
 
-            for (peer = host->peers; peer < &host->peers[host->peerCount]; ++peer) {
+            for (currentNode = enet_list_begin(&host->connectedPeerList); currentNode != enet_list_end(&host->connectedPeerList); currentNode = enet_list_next(currentNode)) {
                 enet_uint32 peerBandwidth;
 
-                if ((peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER) ||
-                    peer->incomingBandwidth == 0 ||
-                    peer->outgoingBandwidthThrottleEpoch == timeCurrent
-                ) {
+                peer = enet_list_peer(currentNode, connectedList);
+                if (peer->incomingBandwidth == 0 || peer->outgoingBandwidthThrottleEpoch == timeCurrent) {
                     continue;
                 }
 
@@ -4803,11 +6841,9 @@ extern "C" {
                 throttle = (bandwidth * ENET_PEER_PACKET_THROTTLE_SCALE) / dataTotal;
             }
 
-            for (peer = host->peers;
-              peer < &host->peers[host->peerCount];
-              ++peer)
-            {
-                if ((peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER) || peer->outgoingBandwidthThrottleEpoch == timeCurrent) {
+            for (currentNode = enet_list_begin(&host->connectedPeerList); currentNode != enet_list_end(&host->connectedPeerList); currentNode = enet_list_next(currentNode)) {
+                peer = enet_list_peer(currentNode, connectedList);
+                if (peer->outgoingBandwidthThrottleEpoch == timeCurrent) {
                     continue;
                 }
 
@@ -4836,10 +6872,9 @@ extern "C" {
                     needsAdjustment = 0;
                     bandwidthLimit  = bandwidth / peersRemaining;
 
-                    for (peer = host->peers; peer < &host->peers[host->peerCount]; ++peer) {
-                        if ((peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER) ||
-                            peer->incomingBandwidthThrottleEpoch == timeCurrent
-                        ) {
+                    for (currentNode = enet_list_begin(&host->connectedPeerList); currentNode != enet_list_end(&host->connectedPeerList); currentNode = enet_list_next(currentNode)) {
+                        peer = enet_list_peer(currentNode, connectedList);
+                        if (peer->incomingBandwidthThrottleEpoch == timeCurrent) {
                             continue;
                         }
 
@@ -4856,10 +6891,8 @@ extern "C" {
                 }
             }
 
-            for (peer = host->peers; peer < &host->peers[host->peerCount]; ++peer) {
-                if (peer->state != ENET_PEER_STATE_CONNECTED && peer->state != ENET_PEER_STATE_DISCONNECT_LATER) {
-                    continue;
-                }
+            for (currentNode = enet_list_begin(&host->connectedPeerList); currentNode != enet_list_end(&host->connectedPeerList); currentNode = enet_list_next(currentNode)) {
+                peer = enet_list_peer(currentNode, connectedList);
 
                 command.header.command   = ENET_PROTOCOL_COMMAND_BANDWIDTH_LIMIT | ENET_PROTOCOL_COMMAND_FLAG_ACKNOWLEDGE;
                 command.header.channelID = 0xFF;
@@ -4876,60 +6909,339 @@ extern "C" {
         }
     } /* enet_host_bandwidth_throttle */
 
-// =======================================================================//
-// !
-// ! Time
-// !
-// =======================================================================//
-
-    #ifdef _WIN32
-        static LARGE_INTEGER getFILETIMEoffset() {
-            SYSTEMTIME s;
-            FILETIME f;
-            LARGE_INTEGER t;
+    /** Creates an empty host group.
+     *  @returns the group, or NULL if the wait or wake handles could not be created
+     */
+    ENetHostGroup * enet_host_group_create(void) {
+        ENetHostGroup *group = (ENetHostGroup *) enet_malloc(sizeof(ENetHostGroup));
 
-            s.wYear = 1970;
-            s.wMonth = 1;
-            s.wDay = 1;
-            s.wHour = 0;
-            s.wMinute = 0;
-            s.wSecond = 0;
-            s.wMilliseconds = 0;
-            SystemTimeToFileTime(&s, &f);
-            t.QuadPart = f.dwHighDateTime;
-            t.QuadPart <<= 32;
-            t.QuadPart |= f.dwLowDateTime;
-            return (t);
+        if (group == NULL) {
+            return NULL;
         }
 
-        int clock_gettime(int X, struct timespec *tv) {
-            LARGE_INTEGER t;
-            FILETIME f;
-            double microseconds;
-            static LARGE_INTEGER offset;
-            static double frequencyToMicroseconds;
-            static int initialized = 0;
-            static BOOL usePerformanceCounter = 0;
+        memset(group, 0, sizeof(ENetHostGroup));
+        group->epoll      = -1;
+        group->wakeEvent  = -1;
+        group->wakeSocket = ENET_SOCKET_NULL;
 
-            if (!initialized) {
-                LARGE_INTEGER performanceFrequency;
-                initialized = 1;
-                usePerformanceCounter = QueryPerformanceFrequency(&performanceFrequency);
-                if (usePerformanceCounter) {
-                    QueryPerformanceCounter(&offset);
-                    frequencyToMicroseconds = (double)performanceFrequency.QuadPart / 1000000.;
-                } else {
-                    offset = getFILETIMEoffset();
-                    frequencyToMicroseconds = 10.;
-                }
+    #ifdef ENET_USE_EPOLL
+        group->epoll     = epoll_create1(EPOLL_CLOEXEC);
+        group->wakeEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (group->epoll >= 0 && group->wakeEvent >= 0) {
+            struct epoll_event event;
+
+            // a NULL pointer marks the wake event, every other entry is a host
+            memset(&event, 0, sizeof(struct epoll_event));
+            event.events   = EPOLLIN;
+            event.data.ptr = NULL;
+
+            if (epoll_ctl(group->epoll, EPOLL_CTL_ADD, group->wakeEvent, &event) == 0) {
+                return group;
             }
-            if (usePerformanceCounter) {
-                QueryPerformanceCounter(&t);
-            } else {
-                GetSystemTimeAsFileTime(&f);
-                t.QuadPart = f.dwHighDateTime;
-                t.QuadPart <<= 32;
-                t.QuadPart |= f.dwLowDateTime;
+        }
+    #else
+        group->wakeSocket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+
+        if (group->wakeSocket != ENET_SOCKET_NULL) {
+            ENetAddress address;
+
+            memset(&address, 0, sizeof(ENetAddress));
+            enet_address_set_host_ip(&address, "127.0.0.1");
+            address.port = 0;
+
+            enet_socket_set_option(group->wakeSocket, ENET_SOCKOPT_IPV6_V6ONLY, 0);
+
+            if (enet_socket_bind(group->wakeSocket, &address) == 0 &&
+                enet_socket_get_address(group->wakeSocket, &group->wakeAddress) == 0 &&
+                enet_socket_set_option(group->wakeSocket, ENET_SOCKOPT_NONBLOCK, 1) == 0
+            ) {
+                return group;
+            }
+        }
+    #endif
+
+        enet_host_group_destroy(group);
+        return NULL;
+    } /* enet_host_group_create */
+
+    /** Destroys a host group. The hosts in it are left alone and can still be serviced on their own.
+     *  @param group the group to destroy
+     */
+    void enet_host_group_destroy(ENetHostGroup *group) {
+        size_t i;
+
+        if (group == NULL) {
+            return;
+        }
+
+        for (i = 0; i < group->hostCount; ++i) {
+            group->hosts[i]->group = NULL;
+        }
+
+    #ifdef ENET_USE_EPOLL
+        if (group->epoll >= 0) {
+            close(group->epoll);
+        }
+
+        if (group->wakeEvent >= 0) {
+            close(group->wakeEvent);
+        }
+    #else
+        if (group->wakeSocket != ENET_SOCKET_NULL) {
+            enet_socket_destroy(group->wakeSocket);
+        }
+    #endif
+
+        enet_free(group->hosts);
+        enet_free(group);
+    } /* enet_host_group_destroy */
+
+    /** Adds a host to a group.
+     *  @param group the group to add to
+     *  @param host the host to add, it can only be in one group at a time
+     *  @retval 0 on success
+     *  @retval < 0 if the host is already in a group or the group could not grow
+     */
+    int enet_host_group_add(ENetHostGroup *group, ENetHost *host) {
+        if (host->group != NULL) {
+            return -1;
+        }
+
+        if (group->hostCount == group->hostCapacity) {
+            size_t capacity   = group->hostCapacity ? group->hostCapacity * 2 : 8;
+            ENetHost **hosts = (ENetHost **) enet_malloc(capacity * sizeof(ENetHost *));
+
+            if (hosts == NULL) {
+                return -1;
+            }
+
+            if (group->hostCount > 0) {
+                memcpy(hosts, group->hosts, group->hostCount * sizeof(ENetHost *));
+            }
+
+            enet_free(group->hosts);
+            group->hosts        = hosts;
+            group->hostCapacity = capacity;
+        }
+
+    #ifdef ENET_USE_EPOLL
+        {
+            struct epoll_event event;
+
+            memset(&event, 0, sizeof(struct epoll_event));
+            event.events   = EPOLLIN;
+            event.data.ptr = host;
+
+            if (epoll_ctl(group->epoll, EPOLL_CTL_ADD, enet_host_descriptor(host), &event) != 0) {
+                return -1;
+            }
+        }
+    #endif
+
+        group->hosts[group->hostCount++] = host;
+        host->group = group;
+
+        return 0;
+    } /* enet_host_group_add */
+
+    /** Removes a host from its group. Destroying a host does this automatically.
+     *  @param group the group the host is in
+     *  @param host the host to remove
+     */
+    void enet_host_group_remove(ENetHostGroup *group, ENetHost *host) {
+        size_t i;
+
+        if (host->group != group) {
+            return;
+        }
+
+        for (i = 0; i < group->hostCount; ++i) {
+            if (group->hosts[i] == host) {
+                group->hosts[i] = group->hosts[--group->hostCount];
+                break;
+            }
+        }
+
+    #ifdef ENET_USE_EPOLL
+        epoll_ctl(group->epoll, EPOLL_CTL_DEL, enet_host_descriptor(host), NULL);
+    #endif
+
+        host->group = NULL;
+    } /* enet_host_group_remove */
+
+    /** Waits until hosts in the group have received data or have a retransmission or ping due, the group
+     *  is woken, or the timeout passes.
+     *  @param group the group to wait on
+     *  @param hosts filled in with the hosts that are ready to be serviced
+     *  @param hostLimit the most hosts to return, ready hosts past the limit are returned by the next wait
+     *  @param timeout number of milliseconds to wait
+     *  @returns the number of hosts written to hosts, 0 on timeout or wake, < 0 on failure
+     *  @remarks The hosts returned should be serviced with enet_host_service(host, &event, 0) until it
+     *  returns 0. Packets queued with enet_peer_send are only sent when their host is serviced or flushed.
+     */
+    int enet_host_group_wait(ENetHostGroup *group, ENetHost **hosts, size_t hostLimit, enet_uint32 timeout) {
+        size_t i, readyCount = 0;
+        enet_uint32 now = enet_time_get(), timerDeadline;
+
+        // datagrams left in a host's receive batch are ready without asking the kernel, and so are hosts with a timer due
+        for (i = 0; i < group->hostCount && readyCount < hostLimit; ++i) {
+            if (enet_host_receive_pending(group->hosts[i])) {
+                hosts[readyCount++] = group->hosts[i];
+            } else if (enet_host_next_timer(group->hosts[i], &timerDeadline)) {
+                if (ENET_TIME_LESS_EQUAL(timerDeadline, now)) {
+                    hosts[readyCount++] = group->hosts[i];
+                } else if (timerDeadline - now < timeout) {
+                    timeout = timerDeadline - now;
+                }
+            }
+        }
+
+        if (readyCount > 0) {
+            return (int) readyCount;
+        }
+
+        {
+        #ifdef ENET_USE_EPOLL
+            struct epoll_event events[ENET_HOST_GROUP_WAIT_EVENTS];
+            int eventCount, j;
+
+            eventCount = epoll_wait(group->epoll, events, (int) ENET_MIN(hostLimit + 1, ENET_HOST_GROUP_WAIT_EVENTS), (int) timeout);
+
+            if (eventCount < 0) {
+                return errno == EINTR ? 0 : -1;
+            }
+
+            for (j = 0; j < eventCount; ++j) {
+                if (events[j].data.ptr == NULL) {
+                    enet_host_group_drain(group);
+                } else if (readyCount < hostLimit) {
+                    hosts[readyCount++] = (ENetHost *) events[j].data.ptr;
+                }
+            }
+        #else
+            ENetSocketSet readSet;
+            ENetSocket maxSocket = group->wakeSocket;
+            int selectCount;
+
+            ENET_SOCKETSET_EMPTY(readSet);
+            ENET_SOCKETSET_ADD(readSet, group->wakeSocket);
+
+            for (i = 0; i < group->hostCount; ++i) {
+                ENET_SOCKETSET_ADD(readSet, enet_host_descriptor(group->hosts[i]));
+                maxSocket = ENET_MAX(maxSocket, enet_host_descriptor(group->hosts[i]));
+            }
+
+            selectCount = enet_socketset_select(maxSocket, &readSet, NULL, timeout);
+
+            if (selectCount < 0) {
+                return -1;
+            }
+
+            if (ENET_SOCKETSET_CHECK(readSet, group->wakeSocket)) {
+                enet_host_group_drain(group);
+            }
+
+            for (i = 0; i < group->hostCount && readyCount < hostLimit; ++i) {
+                if (ENET_SOCKETSET_CHECK(readSet, enet_host_descriptor(group->hosts[i]))) {
+                    hosts[readyCount++] = group->hosts[i];
+                }
+            }
+        #endif
+        }
+
+        // the wait may have been cut short for a timer, those hosts need servicing too
+        now = enet_time_get();
+        for (i = 0; i < group->hostCount && readyCount < hostLimit; ++i) {
+            size_t j;
+
+            if (!enet_host_next_timer(group->hosts[i], &timerDeadline) || ENET_TIME_GREATER(timerDeadline, now)) {
+                continue;
+            }
+
+            for (j = 0; j < readyCount && hosts[j] != group->hosts[i]; ++j) {}
+
+            if (j == readyCount) {
+                hosts[readyCount++] = group->hosts[i];
+            }
+        }
+
+        return (int) readyCount;
+    } /* enet_host_group_wait */
+
+    /** Ends the current enet_host_group_wait on the group, or enet_host_service on one of its hosts,
+     *  right away. Can be called from any thread or from a signal handler. A wake with nobody waiting
+     *  ends the next wait instead.
+     *  @param group the group to wake
+     */
+    void enet_host_group_wake(ENetHostGroup *group) {
+    #ifdef ENET_USE_EPOLL
+        eventfd_write(group->wakeEvent, 1);
+    #else
+        enet_uint8 data = 0;
+        ENetBuffer buffer;
+
+        buffer.data       = &data;
+        buffer.dataLength = 1;
+
+        enet_socket_send(group->wakeSocket, &group->wakeAddress, &buffer, 1);
+    #endif
+    } /* enet_host_group_wake */
+
+// =======================================================================//
+// !
+// ! Time
+// !
+// =======================================================================//
+
+    #ifdef _WIN32
+        static LARGE_INTEGER getFILETIMEoffset() {
+            SYSTEMTIME s;
+            FILETIME f;
+            LARGE_INTEGER t;
+
+            s.wYear = 1970;
+            s.wMonth = 1;
+            s.wDay = 1;
+            s.wHour = 0;
+            s.wMinute = 0;
+            s.wSecond = 0;
+            s.wMilliseconds = 0;
+            SystemTimeToFileTime(&s, &f);
+            t.QuadPart = f.dwHighDateTime;
+            t.QuadPart <<= 32;
+            t.QuadPart |= f.dwLowDateTime;
+            return (t);
+        }
+
+        int clock_gettime(int X, struct timespec *tv) {
+            LARGE_INTEGER t;
+            FILETIME f;
+            double microseconds;
+            static LARGE_INTEGER offset;
+            static double frequencyToMicroseconds;
+            static int initialized = 0;
+            static BOOL usePerformanceCounter = 0;
+
+            if (!initialized) {
+                LARGE_INTEGER performanceFrequency;
+                initialized = 1;
+                usePerformanceCounter = QueryPerformanceFrequency(&performanceFrequency);
+                if (usePerformanceCounter) {
+                    QueryPerformanceCounter(&offset);
+                    frequencyToMicroseconds = (double)performanceFrequency.QuadPart / 1000000.;
+                } else {
+                    offset = getFILETIMEoffset();
+                    frequencyToMicroseconds = 10.;
+                }
+            }
+            if (usePerformanceCounter) {
+                QueryPerformanceCounter(&t);
+            } else {
+                GetSystemTimeAsFileTime(&f);
+                t.QuadPart = f.dwHighDateTime;
+                t.QuadPart <<= 32;
+                t.QuadPart |= f.dwLowDateTime;
             }
 
             t.QuadPart -= offset.QuadPart;
@@ -4957,7 +7269,11 @@ extern "C" {
         }
     #endif
 
-    enet_uint32 enet_time_get() {
+    /** Nanoseconds since the first call, which is made to land at 1ms. Builds with ENET_TIME_COARSE
+     *  read CLOCK_MONOTONIC_COARSE instead, the cheapest clock there is but only as precise as the
+     *  kernel tick. Every ENet time comes from here so they all share one clock and one origin.
+     */
+    static enet_uint64 enet_time_get_ns(void) {
         // TODO enet uses 32 bit timestamps. We should modify it to use
         // 64 bit timestamps, but this is not trivial since we'd end up
         // changing half the structs in enet. For now, retain 32 bits, but
@@ -4971,7 +7287,9 @@ extern "C" {
         static uint64_t start_time_ns = 0;
 
         struct timespec ts;
-    #if defined(CLOCK_MONOTONIC_RAW)
+    #if defined(ENET_TIME_COARSE) && defined(CLOCK_MONOTONIC_COARSE)
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    #elif defined(CLOCK_MONOTONIC_RAW)
         clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
     #else
         clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -5002,8 +7320,15 @@ extern "C" {
             offset_ns = old_value == 0 ? want_value : old_value;
         }
 
-        uint64_t result_in_ns = current_time_ns - offset_ns;
-        return (enet_uint32)(result_in_ns / ns_in_ms);
+        return current_time_ns - offset_ns;
+    }
+
+    enet_uint32 enet_time_get() {
+        return (enet_uint32) (enet_time_get_ns() / 1000000);
+    }
+
+    enet_uint64 enet_time_get_us() {
+        return enet_time_get_ns() / 1000;
     }
 
     void enet_inaddr_map4to6(struct in_addr in, struct in6_addr *out)
@@ -5504,6 +7829,16 @@ extern "C" {
                 result = setsockopt(socket, IPPROTO_IPV6, IPV6_V6ONLY, (char *)&value, sizeof(int));
                 break;
 
+            #ifdef __linux__
+            case ENET_SOCKOPT_UDP_SEGMENT:
+                result = setsockopt(socket, IPPROTO_UDP, UDP_SEGMENT, (char *)&value, sizeof(int));
+                break;
+
+            case ENET_SOCKOPT_UDP_GRO:
+                result = setsockopt(socket, IPPROTO_UDP, UDP_GRO, (char *)&value, sizeof(int));
+                break;
+            #endif
+
             default:
                 break;
         }
@@ -5610,6 +7945,201 @@ extern "C" {
         return sentLength;
     } /* enet_socket_send */
 
+    #ifdef ENET_USE_SENDMMSG
+    static size_t enet_socket_datagram_length(const ENetDatagram *datagram) {
+        size_t i, length = 0;
+
+        for (i = 0; i < datagram->bufferCount; ++i) {
+            length += datagram->buffers[i].dataLength;
+        }
+
+        return length;
+    }
+    #endif
+
+    int enet_socket_send_batch(ENetSocket socket, ENetDatagram *datagrams, size_t datagramCount, int *segmentation) {
+    #ifdef ENET_USE_SENDMMSG
+        struct mmsghdr msgHdrs[ENET_HOST_SEND_BATCH];
+        struct sockaddr_in6 sins[ENET_HOST_SEND_BATCH];
+        union { char data[CMSG_SPACE(sizeof(enet_uint16))]; struct cmsghdr align; } controls[ENET_HOST_SEND_BATCH];
+        struct iovec segmentBuffers[ENET_SOCKET_SEGMENT_BUFFERS_MAXIMUM];
+        size_t order[ENET_HOST_SEND_BATCH], runs[ENET_HOST_SEND_BATCH + 1];
+        enet_uint8 queued[ENET_HOST_SEND_BATCH];
+        size_t first, count, i, j, k, messageCount, orderCount, segmentBufferCount;
+        int sentCount;
+
+        for (first = 0; first < datagramCount; first += count) {
+            count = ENET_MIN(datagramCount - first, ENET_HOST_SEND_BATCH);
+
+            memset(queued, 0, count);
+            messageCount       = 0;
+            orderCount         = 0;
+            segmentBufferCount = 0;
+
+            for (i = 0; i < count; ++i) {
+                ENetDatagram *datagram = &datagrams[first + i];
+                struct msghdr *msgHdr  = &msgHdrs[messageCount].msg_hdr;
+                struct sockaddr_in6 *sin = &sins[messageCount];
+
+                if (queued[i]) {
+                    continue;
+                }
+
+                memset(&msgHdrs[messageCount], 0, sizeof(struct mmsghdr));
+                memset(sin, 0, sizeof(struct sockaddr_in6));
+
+                sin->sin6_family   = AF_INET6;
+                sin->sin6_port     = ENET_HOST_TO_NET_16(datagram->address.port);
+                sin->sin6_addr     = datagram->address.host;
+                sin->sin6_scope_id = datagram->address.sin6_scope_id;
+
+                msgHdr->msg_name    = sin;
+                msgHdr->msg_namelen = sizeof(struct sockaddr_in6);
+                msgHdr->msg_iov     = (struct iovec *) datagram->buffers;
+                msgHdr->msg_iovlen  = datagram->bufferCount;
+
+                runs[messageCount]  = orderCount;
+                order[orderCount++] = i;
+                queued[i]           = 1;
+                datagram->sentLength = 0;
+
+                if (segmentation != NULL && *segmentation) {
+                    size_t segmentSize = enet_socket_datagram_length(datagram), dataLength = segmentSize, segments = 1;
+
+                    // gather later datagrams to the same address into one message. Each must be the same size
+                    // except for a shorter last one, and none can be skipped or they would arrive out of order
+                    for (j = i + 1; j < count; ++j) {
+                        ENetDatagram *next = &datagrams[first + j];
+                        size_t nextLength, buffersNeeded;
+
+                        if (queued[j] || !in6_equal(next->address.host, datagram->address.host) || next->address.port != datagram->address.port) {
+                            continue;
+                        }
+
+                        nextLength    = enet_socket_datagram_length(next);
+                        buffersNeeded = next->bufferCount + (segments == 1 ? datagram->bufferCount : 0);
+
+                        if (nextLength > segmentSize ||
+                            segments >= ENET_SOCKET_SEGMENTS_MAXIMUM ||
+                            dataLength + nextLength > ENET_SOCKET_SEGMENT_DATA_MAXIMUM ||
+                            segmentBufferCount + buffersNeeded > ENET_SOCKET_SEGMENT_BUFFERS_MAXIMUM
+                        ) {
+                            break;
+                        }
+
+                        if (segments == 1) {
+                            msgHdr->msg_iov = &segmentBuffers[segmentBufferCount];
+
+                            for (k = 0; k < datagram->bufferCount; ++k) {
+                                segmentBuffers[segmentBufferCount].iov_base  = datagram->buffers[k].data;
+                                segmentBuffers[segmentBufferCount].iov_len   = datagram->buffers[k].dataLength;
+                                ++segmentBufferCount;
+                            }
+
+                            msgHdr->msg_iovlen = datagram->bufferCount;
+                        }
+
+                        for (k = 0; k < next->bufferCount; ++k) {
+                            segmentBuffers[segmentBufferCount].iov_base  = next->buffers[k].data;
+                            segmentBuffers[segmentBufferCount].iov_len   = next->buffers[k].dataLength;
+                            ++segmentBufferCount;
+                        }
+
+                        msgHdr->msg_iovlen += next->bufferCount;
+                        order[orderCount++] = j;
+                        queued[j]           = 1;
+                        next->sentLength    = 0;
+                        dataLength         += nextLength;
+                        ++segments;
+
+                        if (nextLength < segmentSize) {
+                            break;
+                        }
+                    }
+
+                    if (segments > 1) {
+                        enet_uint16 gsoSize = (enet_uint16) segmentSize;
+                        struct cmsghdr *cmsg;
+
+                        msgHdr->msg_control    = controls[messageCount].data;
+                        msgHdr->msg_controllen = sizeof(controls[messageCount].data);
+
+                        cmsg             = CMSG_FIRSTHDR(msgHdr);
+                        cmsg->cmsg_level = IPPROTO_UDP;
+                        cmsg->cmsg_type  = UDP_SEGMENT;
+                        cmsg->cmsg_len   = CMSG_LEN(sizeof(enet_uint16));
+                        memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(enet_uint16));
+                    }
+                }
+
+                ++messageCount;
+            }
+
+            runs[messageCount] = orderCount;
+
+            // sendmmsg can stop early, keep going from the first message it did not take
+            for (i = 0; i < messageCount; i += sentCount) {
+                sentCount = sendmmsg(socket, &msgHdrs[i], (unsigned int) (messageCount - i), MSG_NOSIGNAL);
+
+                if (sentCount == -1) {
+                    if (errno == EWOULDBLOCK) {
+                        // like enet_socket_send, a full socket buffer drops the rest instead of failing
+                        return (int) datagramCount;
+                    }
+
+                    if (msgHdrs[i].msg_hdr.msg_controllen > 0 &&
+                        (errno == EIO || errno == EINVAL || errno == EOPNOTSUPP || errno == ENOPROTOOPT)
+                    ) {
+                        // the kernel or the route can't segment, send the rest of this chunk one datagram at a time
+                        *segmentation = 0;
+
+                        for (k = runs[i]; k < orderCount; ++k) {
+                            ENetDatagram *datagram = &datagrams[first + order[k]];
+
+                            datagram->sentLength = enet_socket_send(socket, &datagram->address, datagram->buffers, datagram->bufferCount);
+                            if (datagram->sentLength < 0) {
+                                return -1;
+                            }
+                        }
+
+                        break;
+                    }
+
+                    return -1;
+                }
+
+                for (j = i; j < i + (size_t) sentCount; ++j) {
+                    if (runs[j + 1] - runs[j] == 1) {
+                        datagrams[first + order[runs[j]]].sentLength = (int) msgHdrs[j].msg_len;
+                        continue;
+                    }
+
+                    for (k = runs[j]; k < runs[j + 1]; ++k) {
+                        ENetDatagram *datagram = &datagrams[first + order[k]];
+                        datagram->sentLength = (int) enet_socket_datagram_length(datagram);
+                    }
+                }
+            }
+        }
+
+        return (int) datagramCount;
+    #else
+        size_t i;
+
+        ENET_UNUSED(segmentation)
+
+        for (i = 0; i < datagramCount; ++i) {
+            datagrams[i].sentLength = enet_socket_send(socket, &datagrams[i].address, datagrams[i].buffers, datagrams[i].bufferCount);
+
+            if (datagrams[i].sentLength < 0) {
+                return -1;
+            }
+        }
+
+        return (int) datagramCount;
+    #endif
+    } /* enet_socket_send_batch */
+
     int enet_socket_receive(ENetSocket socket, ENetAddress *address, ENetBuffer *buffers, size_t bufferCount) {
         struct msghdr msgHdr;
         struct sockaddr_in6 sin;
@@ -5648,6 +8178,95 @@ extern "C" {
         return recvLength;
     } /* enet_socket_receive */
 
+    int enet_socket_receive_batch(ENetSocket socket, ENetAddress *addresses, ENetBuffer *buffers, size_t bufferCount, size_t *segmentSizes) {
+    #ifdef ENET_USE_RECVMMSG
+        struct mmsghdr msgHdrs[ENET_HOST_RECEIVE_BATCH];
+        struct sockaddr_in6 sins[ENET_HOST_RECEIVE_BATCH];
+        union { char data[CMSG_SPACE(sizeof(int))]; struct cmsghdr align; } controls[ENET_HOST_RECEIVE_BATCH];
+        int receivedCount, i;
+
+        if (bufferCount > ENET_HOST_RECEIVE_BATCH) {
+            bufferCount = ENET_HOST_RECEIVE_BATCH;
+        }
+
+        memset(msgHdrs, 0, bufferCount * sizeof(struct mmsghdr));
+
+        for (i = 0; i < (int) bufferCount; ++i) {
+            if (addresses != NULL) {
+                msgHdrs[i].msg_hdr.msg_name    = &sins[i];
+                msgHdrs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in6);
+            }
+
+            // with UDP_GRO on, a buffer can hold several datagrams and the kernel reports their size here
+            if (segmentSizes != NULL) {
+                msgHdrs[i].msg_hdr.msg_control    = controls[i].data;
+                msgHdrs[i].msg_hdr.msg_controllen = sizeof(controls[i].data);
+            }
+
+            msgHdrs[i].msg_hdr.msg_iov    = (struct iovec *) &buffers[i];
+            msgHdrs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        receivedCount = recvmmsg(socket, msgHdrs, (unsigned int) bufferCount, MSG_NOSIGNAL, NULL);
+
+        if (receivedCount == -1) {
+            if (errno == EWOULDBLOCK) {
+                return 0;
+            }
+
+            return -1;
+        }
+
+        for (i = 0; i < receivedCount; ++i) {
+            buffers[i].dataLength = (msgHdrs[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : msgHdrs[i].msg_len;
+
+            if (segmentSizes != NULL) {
+                struct cmsghdr *cmsg;
+
+                segmentSizes[i] = 0;
+
+                for (cmsg = CMSG_FIRSTHDR(&msgHdrs[i].msg_hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msgHdrs[i].msg_hdr, cmsg)) {
+                    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+                        int gsoSize;
+                        memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(int));
+                        segmentSizes[i] = gsoSize > 0 ? (size_t) gsoSize : 0;
+                    }
+                }
+            }
+
+            if (addresses != NULL) {
+                addresses[i].host          = sins[i].sin6_addr;
+                addresses[i].port          = ENET_NET_TO_HOST_16(sins[i].sin6_port);
+                addresses[i].sin6_scope_id = sins[i].sin6_scope_id;
+            }
+        }
+
+        return receivedCount;
+    #else
+        size_t i;
+
+        for (i = 0; i < bufferCount; ++i) {
+            int recvLength = enet_socket_receive(socket, addresses != NULL ? &addresses[i] : NULL, &buffers[i], 1);
+
+            if (recvLength < 0) {
+                return i > 0 ? (int) i : -1;
+            }
+
+            if (recvLength == 0) {
+                break;
+            }
+
+            buffers[i].dataLength = (size_t) recvLength;
+
+            if (segmentSizes != NULL) {
+                segmentSizes[i] = 0;
+            }
+        }
+
+        return (int) i;
+    #endif
+    } /* enet_socket_receive_batch */
+
     int enet_socketset_select(ENetSocket maxSocket, ENetSocketSet *readSet, ENetSocketSet *writeSet, enet_uint32 timeout) {
         struct timeval timeVal;
 
@@ -5701,6 +8320,404 @@ extern "C" {
         return 0;
     } /* enet_socket_wait */
 
+    #ifdef ENET_USE_IO_URING
+
+    /* user_data of a completion: a receive slot index, or one of these tags and a send batch index */
+    #define ENET_URING_SEND   ((enet_uint64) 1 << 32)
+    #define ENET_URING_CANCEL ((enet_uint64) 2 << 32)
+
+    /** State of a host using ENET_HOST_TRANSPORT_URING. Every slot of the host's receive ring is always
+     *  in one place: posted to the kernel, completed and waiting in receiveReady, or handed to the protocol
+     *  in host->receiveBatch until the batch is used up.
+     */
+    typedef struct _ENetUring {
+        int                   descriptor;
+        void *                ring;                 /**< submission and completion rings, mapped together */
+        size_t                ringSize;
+        struct io_uring_sqe * entries;
+        size_t                entriesSize;
+        unsigned *            submitHead;
+        unsigned *            submitTail;
+        unsigned *            submitArray;
+        unsigned              submitMask;
+        unsigned              submitEntries;
+        unsigned              submitCount;          /**< entries queued since the last io_uring_enter */
+        unsigned *            completeHead;
+        unsigned *            completeTail;
+        unsigned              completeMask;
+        struct io_uring_cqe * completions;
+        struct msghdr         receiveMessages[ENET_HOST_RECEIVE_BATCH];
+        struct sockaddr_in6   receiveNames[ENET_HOST_RECEIVE_BATCH];
+        struct iovec          receiveVectors[ENET_HOST_RECEIVE_BATCH];
+        int                   receiveResults[ENET_HOST_RECEIVE_BATCH];
+        size_t                receiveReady[ENET_HOST_RECEIVE_BATCH];
+        size_t                receiveReadyCount;
+        size_t                receiveHanded[ENET_HOST_RECEIVE_BATCH];
+        size_t                receiveHandedCount;
+        size_t                receivesPosted;
+        struct msghdr         sendMessages[ENET_HOST_SEND_BATCH];
+        struct sockaddr_in6   sendNames[ENET_HOST_SEND_BATCH];
+        int                   sendResults[ENET_HOST_SEND_BATCH];
+        size_t                sendsInFlight;
+    } ENetUring;
+
+    /** Submits the queued entries and, with IORING_ENTER_GETEVENTS, waits for minComplete completions. */
+    static int enet_uring_enter(ENetUring *uring, unsigned minComplete, unsigned flags) {
+        int result;
+
+        do {
+            result = (int) syscall(__NR_io_uring_enter, uring->descriptor, uring->submitCount, minComplete, flags, NULL, 0);
+        } while (result < 0 && errno == EINTR);
+
+        if (result < 0) {
+            return -1;
+        }
+
+        uring->submitCount -= (unsigned) result;
+        return 0;
+    }
+
+    static struct io_uring_sqe * enet_uring_entry(ENetUring *uring) {
+        struct io_uring_sqe *entry;
+        unsigned tail = *uring->submitTail;
+
+        // the ring is sized for a full receive ring plus a full send batch, this only triggers on cancel storms
+        if (tail - __atomic_load_n(uring->submitHead, __ATOMIC_ACQUIRE) >= uring->submitEntries) {
+            if (enet_uring_enter(uring, 0, 0) < 0) {
+                return NULL;
+            }
+        }
+
+        entry = &uring->entries[tail & uring->submitMask];
+        memset(entry, 0, sizeof(struct io_uring_sqe));
+
+        uring->submitArray[tail & uring->submitMask] = tail & uring->submitMask;
+        __atomic_store_n(uring->submitTail, tail + 1, __ATOMIC_RELEASE);
+        ++uring->submitCount;
+
+        return entry;
+    }
+
+    /** Moves finished completions into the receive and send results. */
+    static void enet_uring_reap(ENetUring *uring) {
+        unsigned head = *uring->completeHead;
+        unsigned tail = __atomic_load_n(uring->completeTail, __ATOMIC_ACQUIRE);
+
+        for (; head != tail; ++head) {
+            const struct io_uring_cqe *completion = &uring->completions[head & uring->completeMask];
+            size_t index = (size_t) (completion->user_data & 0xFFFFFFFF);
+
+            if (completion->user_data & ENET_URING_CANCEL) {
+                continue;
+            }
+
+            if (completion->user_data & ENET_URING_SEND) {
+                uring->sendResults[index] = completion->res;
+                --uring->sendsInFlight;
+                continue;
+            }
+
+            uring->receiveResults[index] = completion->res;
+            uring->receiveReady[uring->receiveReadyCount++] = index;
+            --uring->receivesPosted;
+        }
+
+        __atomic_store_n(uring->completeHead, head, __ATOMIC_RELEASE);
+    }
+
+    /** Posts a receive into one slot of the host's receive ring. */
+    static int enet_uring_post_receive(ENetHost *host, size_t slot) {
+        ENetUring *uring      = host->uring;
+        struct msghdr *msgHdr = &uring->receiveMessages[slot];
+        struct io_uring_sqe *entry = enet_uring_entry(uring);
+
+        if (entry == NULL) {
+            return -1;
+        }
+
+        uring->receiveVectors[slot].iov_base = host->receiveBuffers + slot * host->receiveBufferSize;
+        uring->receiveVectors[slot].iov_len  = host->receiveBufferSize;
+
+        memset(msgHdr, 0, sizeof(struct msghdr));
+        msgHdr->msg_name    = &uring->receiveNames[slot];
+        msgHdr->msg_namelen = sizeof(struct sockaddr_in6);
+        msgHdr->msg_iov     = &uring->receiveVectors[slot];
+        msgHdr->msg_iovlen  = 1;
+
+        // MSG_TRUNC makes the result the full datagram length, so a datagram too big for the slot is noticed
+        entry->opcode    = IORING_OP_RECVMSG;
+        entry->fd        = host->socket;
+        entry->addr      = (enet_uint64) (uintptr_t) msgHdr;
+        entry->len       = 1;
+        entry->msg_flags = MSG_TRUNC;
+        entry->user_data = slot;
+
+        ++uring->receivesPosted;
+        return 0;
+    }
+
+    /** Sets up io_uring for the host and posts its whole receive ring.
+     *  @retval 0 on success
+     *  @retval < 0 if the kernel has no usable io_uring, the host is left on the socket transport
+     */
+    int enet_uring_create(ENetHost *host) {
+        struct io_uring_params params;
+        ENetUring *uring;
+        unsigned char *ring;
+        size_t slot;
+
+        uring = (ENetUring *) enet_malloc(sizeof(ENetUring));
+        if (uring == NULL) {
+            return -1;
+        }
+
+        memset(uring, 0, sizeof(ENetUring));
+        memset(&params, 0, sizeof(struct io_uring_params));
+
+        uring->ring    = MAP_FAILED;
+        uring->entries = (struct io_uring_sqe *) MAP_FAILED;
+        host->uring    = uring;
+
+        uring->descriptor = (int) syscall(__NR_io_uring_setup, ENET_HOST_RECEIVE_BATCH + ENET_HOST_SEND_BATCH, &params);
+
+        // one mapping for both rings (5.4) keeps this simple, older kernels use the socket transport
+        if (uring->descriptor < 0 || !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+            goto uringError;
+        }
+
+        uring->ringSize = ENET_MAX(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                   params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+        uring->ring     = mmap(NULL, uring->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->descriptor, IORING_OFF_SQ_RING);
+
+        uring->entriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        uring->entries     = (struct io_uring_sqe *) mmap(NULL, uring->entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->descriptor, IORING_OFF_SQES);
+
+        if (uring->ring == MAP_FAILED || uring->entries == MAP_FAILED) {
+            goto uringError;
+        }
+
+        ring = (unsigned char *) uring->ring;
+
+        uring->submitHead    = (unsigned *) (ring + params.sq_off.head);
+        uring->submitTail    = (unsigned *) (ring + params.sq_off.tail);
+        uring->submitArray   = (unsigned *) (ring + params.sq_off.array);
+        uring->submitMask    = *(unsigned *) (ring + params.sq_off.ring_mask);
+        uring->submitEntries = params.sq_entries;
+        uring->completeHead  = (unsigned *) (ring + params.cq_off.head);
+        uring->completeTail  = (unsigned *) (ring + params.cq_off.tail);
+        uring->completeMask  = *(unsigned *) (ring + params.cq_off.ring_mask);
+        uring->completions   = (struct io_uring_cqe *) (ring + params.cq_off.cqes);
+
+        for (slot = 0; slot < host->receiveBufferCount; ++slot) {
+            if (enet_uring_post_receive(host, slot) < 0) {
+                goto uringError;
+            }
+        }
+
+        if (enet_uring_enter(uring, 0, 0) < 0) {
+            goto uringError;
+        }
+
+        return 0;
+
+    uringError:
+        enet_uring_destroy(host);
+        return -1;
+    } /* enet_uring_create */
+
+    /** Cancels the posted receives, waits for the kernel to let go of the receive ring and frees the io_uring state. */
+    void enet_uring_destroy(ENetHost *host) {
+        ENetUring *uring = host->uring;
+        size_t slot;
+        int attempts;
+
+        if (uring->entries != MAP_FAILED && uring->ring != MAP_FAILED) {
+            enet_uring_reap(uring);
+
+            // the receive slots that are neither completed nor handed out are still posted
+            for (slot = 0; slot < host->receiveBufferCount; ++slot) {
+                struct io_uring_sqe *entry;
+                size_t i;
+                int posted = 1;
+
+                for (i = 0; i < uring->receiveReadyCount && posted; ++i) {
+                    posted = uring->receiveReady[i] != slot;
+                }
+
+                for (i = 0; i < uring->receiveHandedCount && posted; ++i) {
+                    posted = uring->receiveHanded[i] != slot;
+                }
+
+                if (!posted || (entry = enet_uring_entry(uring)) == NULL) {
+                    continue;
+                }
+
+                entry->opcode    = IORING_OP_ASYNC_CANCEL;
+                entry->fd        = -1;
+                entry->addr      = slot;
+                entry->user_data = ENET_URING_CANCEL | slot;
+            }
+
+            // closing the ring cancels too, but only this guarantees nothing writes to the buffers after they are freed
+            for (attempts = 0; uring->receivesPosted > 0 && attempts < 64; ++attempts) {
+                if (enet_uring_enter(uring, 1, IORING_ENTER_GETEVENTS) < 0) {
+                    break;
+                }
+
+                enet_uring_reap(uring);
+            }
+        }
+
+        if (uring->entries != MAP_FAILED) {
+            munmap(uring->entries, uring->entriesSize);
+        }
+
+        if (uring->ring != MAP_FAILED) {
+            munmap(uring->ring, uring->ringSize);
+        }
+
+        if (uring->descriptor >= 0) {
+            close(uring->descriptor);
+        }
+
+        enet_free(uring);
+        host->uring = NULL;
+    } /* enet_uring_destroy */
+
+    int enet_uring_descriptor(ENetHost *host) {
+        return host->uring->descriptor;
+    }
+
+    int enet_uring_pending(ENetHost *host) {
+        ENetUring *uring = host->uring;
+
+        return uring->receiveReadyCount > 0 || *uring->completeHead != __atomic_load_n(uring->completeTail, __ATOMIC_ACQUIRE);
+    }
+
+    /** Submits the datagrams with one io_uring_enter per ENET_HOST_SEND_BATCH and waits until the kernel is done
+     *  with them, as the caller reuses their buffers right away. Works like enet_socket_send_batch.
+     */
+    int enet_uring_send_batch(ENetHost *host, ENetDatagram *datagrams, size_t datagramCount) {
+        ENetUring *uring = host->uring;
+        size_t first, count, i;
+
+        for (first = 0; first < datagramCount; first += count) {
+            count = ENET_MIN(datagramCount - first, ENET_HOST_SEND_BATCH);
+
+            for (i = 0; i < count; ++i) {
+                ENetDatagram *datagram   = &datagrams[first + i];
+                struct msghdr *msgHdr    = &uring->sendMessages[i];
+                struct sockaddr_in6 *sin = &uring->sendNames[i];
+                struct io_uring_sqe *entry = enet_uring_entry(uring);
+
+                if (entry == NULL) {
+                    return -1;
+                }
+
+                memset(sin, 0, sizeof(struct sockaddr_in6));
+                sin->sin6_family   = AF_INET6;
+                sin->sin6_port     = ENET_HOST_TO_NET_16(datagram->address.port);
+                sin->sin6_addr     = datagram->address.host;
+                sin->sin6_scope_id = datagram->address.sin6_scope_id;
+
+                memset(msgHdr, 0, sizeof(struct msghdr));
+                msgHdr->msg_name    = sin;
+                msgHdr->msg_namelen = sizeof(struct sockaddr_in6);
+                msgHdr->msg_iov     = (struct iovec *) datagram->buffers;
+                msgHdr->msg_iovlen  = datagram->bufferCount;
+
+                // MSG_DONTWAIT keeps the socket transport's behaviour of dropping datagrams when the socket buffer is full
+                entry->opcode    = IORING_OP_SENDMSG;
+                entry->fd        = host->socket;
+                entry->addr      = (enet_uint64) (uintptr_t) msgHdr;
+                entry->len       = 1;
+                entry->msg_flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+                entry->user_data = ENET_URING_SEND | i;
+
+                uring->sendResults[i] = 0;
+                ++uring->sendsInFlight;
+            }
+
+            // UDP sends complete while they are submitted, so this normally returns without sleeping
+            if (enet_uring_enter(uring, 0, 0) < 0) {
+                return -1;
+            }
+
+            enet_uring_reap(uring);
+
+            while (uring->sendsInFlight > 0) {
+                if (enet_uring_enter(uring, 1, IORING_ENTER_GETEVENTS) < 0) {
+                    return -1;
+                }
+
+                enet_uring_reap(uring);
+            }
+
+            for (i = 0; i < count; ++i) {
+                int result = uring->sendResults[i];
+
+                if (result < 0 && result != -EAGAIN && result != -EWOULDBLOCK && result != -ENOBUFS) {
+                    errno = -result;
+                    return -1;
+                }
+
+                datagrams[first + i].sentLength = result > 0 ? result : 0;
+            }
+        }
+
+        return (int) datagramCount;
+    } /* enet_uring_send_batch */
+
+    /** Fills host->receiveBatch with the receives that completed, after posting the slots of the previous
+     *  batch again. Works like enet_socket_receive_batch, but the batch points into whichever slots completed.
+     */
+    int enet_uring_receive_batch(ENetHost *host) {
+        ENetUring *uring = host->uring;
+        size_t i;
+
+        // the protocol is done with the last batch, its slots go back to the kernel
+        for (i = 0; i < uring->receiveHandedCount; ++i) {
+            if (enet_uring_post_receive(host, uring->receiveHanded[i]) < 0) {
+                return -1;
+            }
+        }
+
+        uring->receiveHandedCount = 0;
+
+        // entering the kernel submits the reposts and runs any receive work that has not posted its completion yet
+        if (uring->submitCount > 0 || !enet_uring_pending(host)) {
+            if (enet_uring_enter(uring, 0, IORING_ENTER_GETEVENTS) < 0) {
+                return -1;
+            }
+        }
+
+        enet_uring_reap(uring);
+
+        for (i = 0; i < uring->receiveReadyCount; ++i) {
+            size_t slot = uring->receiveReady[i];
+            int result  = uring->receiveResults[slot];
+            const struct sockaddr_in6 *sin = &uring->receiveNames[slot];
+
+            // failed and truncated receives come back empty, like they do from the socket transport
+            host->receiveBatch[i].data       = host->receiveBuffers + slot * host->receiveBufferSize;
+            host->receiveBatch[i].dataLength = (result > 0 && (size_t) result <= host->receiveBufferSize) ? (size_t) result : 0;
+            host->receiveSegmentSizes[i]     = 0;
+
+            host->receiveAddresses[i].host          = sin->sin6_addr;
+            host->receiveAddresses[i].port          = ENET_NET_TO_HOST_16(sin->sin6_port);
+            host->receiveAddresses[i].sin6_scope_id = sin->sin6_scope_id;
+
+            uring->receiveHanded[i] = slot;
+        }
+
+        uring->receiveHandedCount = uring->receiveReadyCount;
+        uring->receiveReadyCount  = 0;
+
+        return (int) uring->receiveHandedCount;
+    } /* enet_uring_receive_batch */
+
+    #endif // ENET_USE_IO_URING
+
     #endif // !_WIN32
 
 
@@ -5989,6 +9006,22 @@ extern "C" {
         return (int) sentLength;
     }
 
+    int enet_socket_send_batch(ENetSocket socket, ENetDatagram *datagrams, size_t datagramCount, int *segmentation) {
+        size_t i;
+
+        ENET_UNUSED(segmentation)
+
+        for (i = 0; i < datagramCount; ++i) {
+            datagrams[i].sentLength = enet_socket_send(socket, &datagrams[i].address, datagrams[i].buffers, datagrams[i].bufferCount);
+
+            if (datagrams[i].sentLength < 0) {
+                return -1;
+            }
+        }
+
+        return (int) datagramCount;
+    } /* enet_socket_send_batch */
+
     int enet_socket_receive(ENetSocket socket, ENetAddress *address, ENetBuffer *buffers, size_t bufferCount) {
         INT sinLength = sizeof(struct sockaddr_in6);
         DWORD flags   = 0, recvLength;
@@ -6026,6 +9059,30 @@ extern "C" {
         return (int) recvLength;
     } /* enet_socket_receive */
 
+    int enet_socket_receive_batch(ENetSocket socket, ENetAddress *addresses, ENetBuffer *buffers, size_t bufferCount, size_t *segmentSizes) {
+        size_t i;
+
+        for (i = 0; i < bufferCount; ++i) {
+            int recvLength = enet_socket_receive(socket, addresses != NULL ? &addresses[i] : NULL, &buffers[i], 1);
+
+            if (recvLength < 0) {
+                return i > 0 ? (int) i : -1;
+            }
+
+            if (recvLength == 0) {
+                break;
+            }
+
+            buffers[i].dataLength = (size_t) recvLength;
+
+            if (segmentSizes != NULL) {
+                segmentSizes[i] = 0;
+            }
+        }
+
+        return (int) i;
+    } /* enet_socket_receive_batch */
+
     int enet_socketset_select(ENetSocket maxSocket, ENetSocketSet *readSet, ENetSocketSet *writeSet, enet_uint32 timeout) {
         struct timeval timeVal;
 
@@ -0,0 +1,250 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// implementation of packet capture and capture reading
+
+#include "capture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <time.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+// how much the capture buffers before it writes to the file, so recording doesn't cost a write call per message
+#define CaptureBufferSize (256 * 1024)
+
+struct NetCapture
+{
+    FILE* File;
+
+    // when the capture was started, record timestamps are relative to this
+    uint64_t StartTime;
+};
+
+struct NetCaptureReader
+{
+    // the whole file mapped into memory
+    const uint8_t* Data;
+    size_t Length;
+
+    // where the next record starts
+    size_t Offset;
+
+#if defined(_WIN32)
+    HANDLE File;
+    HANDLE Mapping;
+#endif
+};
+
+uint64_t NetCaptureClock()
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+NetCapture* NetCaptureOpen(const char* fileName)
+{
+    // a capture is one session, its timestamps start at 0 and its connection ids are only unique within it
+    // so an old capture with the same name is replaced rather than added to
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL)
+        return NULL;
+
+    NetCapture* capture = (NetCapture*)malloc(sizeof(NetCapture));
+    if (capture == NULL)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    capture->File = file;
+    capture->StartTime = NetCaptureClock();
+    setvbuf(file, NULL, _IOFBF, CaptureBufferSize);
+
+    uint32_t header[2] = { NetCaptureMagic, NetCaptureVersion };
+    fwrite(header, sizeof(header), 1, file);
+
+    return capture;
+}
+
+void NetCaptureFlush(NetCapture* capture)
+{
+    if (capture != NULL)
+        fflush(capture->File);
+}
+
+void NetCaptureClose(NetCapture* capture)
+{
+    if (capture == NULL)
+        return;
+
+    fclose(capture->File);
+    free(capture);
+}
+
+void NetCaptureWrite(NetCapture* capture, uint16_t connection, NetCaptureDirection direction, const uint8_t* data, size_t length)
+{
+    if (capture == NULL)
+        return;
+
+    NetCaptureRecord record = { 0 };
+    record.Timestamp = NetCaptureClock() - capture->StartTime;
+    record.Length = (uint32_t)length;
+    record.Connection = connection;
+    record.Direction = (uint8_t)direction;
+    record.Command = length > 0 && direction <= CaptureSent ? data[0] : 0;
+
+    fwrite(&record, sizeof(record), 1, capture->File);
+    if (length > 0)
+        fwrite(data, 1, length, capture->File);
+}
+
+NetCaptureReader* NetCaptureReaderOpen(const char* fileName)
+{
+    NetCaptureReader* reader = (NetCaptureReader*)malloc(sizeof(NetCaptureReader));
+    if (reader == NULL)
+        return NULL;
+
+    memset(reader, 0, sizeof(NetCaptureReader));
+
+#if defined(_WIN32)
+    reader->File = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (reader->File == INVALID_HANDLE_VALUE)
+    {
+        free(reader);
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(reader->File, &size);
+    reader->Length = (size_t)size.QuadPart;
+
+    reader->Mapping = reader->Length > 0 ? CreateFileMappingA(reader->File, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    if (reader->Mapping != NULL)
+        reader->Data = (const uint8_t*)MapViewOfFile(reader->Mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    int file = open(fileName, O_RDONLY);
+    if (file < 0)
+    {
+        free(reader);
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        reader->Length = (size_t)info.st_size;
+        void* data = mmap(NULL, reader->Length, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            reader->Data = (const uint8_t*)data;
+
+            // replays read the file front to back
+            madvise(data, reader->Length, MADV_SEQUENTIAL);
+        }
+    }
+
+    // the mapping stays valid after the file is closed
+    close(file);
+#endif
+
+    // make sure this is a capture we know how to read
+    uint32_t header[2] = { 0 };
+    if (reader->Data != NULL && reader->Length >= sizeof(header))
+        memcpy(header, reader->Data, sizeof(header));
+
+    if (header[0] != NetCaptureMagic || header[1] != NetCaptureVersion)
+    {
+        NetCaptureReaderClose(reader);
+        return NULL;
+    }
+
+    NetCaptureReaderRewind(reader);
+    return reader;
+}
+
+void NetCaptureReaderClose(NetCaptureReader* reader)
+{
+    if (reader == NULL)
+        return;
+
+#if defined(_WIN32)
+    if (reader->Data != NULL)
+        UnmapViewOfFile(reader->Data);
+    if (reader->Mapping != NULL)
+        CloseHandle(reader->Mapping);
+    CloseHandle(reader->File);
+#else
+    if (reader->Data != NULL)
+        munmap((void*)reader->Data, reader->Length);
+#endif
+
+    free(reader);
+}
+
+void NetCaptureReaderRewind(NetCaptureReader* reader)
+{
+    // skip over the magic and version
+    reader->Offset = sizeof(uint32_t) * 2;
+}
+
+bool NetCaptureReaderNext(NetCaptureReader* reader, NetCaptureRecord* record, const uint8_t** data)
+{
+    // a capture that was cut off (the program crashed before flushing) just ends at the last complete record
+    if (reader->Offset + sizeof(NetCaptureRecord) > reader->Length)
+        return false;
+
+    memcpy(record, reader->Data + reader->Offset, sizeof(NetCaptureRecord));
+    if (reader->Offset + sizeof(NetCaptureRecord) + record->Length > reader->Length)
+        return false;
+
+    *data = reader->Data + reader->Offset + sizeof(NetCaptureRecord);
+    reader->Offset += sizeof(NetCaptureRecord) + record->Length;
+    return true;
+}
@@ -0,0 +1,123 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// Packet capture for the game protocol.
+// A capture is a compact append only binary log of every application message a client or server sent or received,
+// along with when it happened, what connection it was for and what command it was.
+// Captures can be mapped back into memory and fed through the client or server game play with no sockets (see tools/replay)
+// so real traffic can be used as a repeatable benchmark and regression check.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// the first bytes of every capture file, followed by a 32 bit version
+// the version goes up when the messages inside change, version 2 has 32 bit entity ids, version 3 has tick and budget records
+#define NetCaptureMagic 0x5041434e // 'NCAP'
+#define NetCaptureVersion 3
+
+// What happened to a message
+typedef enum
+{
+    // the message was received from the connection
+    CaptureReceived = 0,
+
+    // the message was sent to the connection
+    CaptureSent = 1,
+
+    // the connection was made, there is no message data
+    CaptureConnected = 2,
+
+    // the connection was lost, there is no message data
+    CaptureDisconnected = 3,
+
+    // the server simulation clock was started or a tick ran, the data is the double the server passed to NetServerUpdate
+    CaptureTick = 4,
+
+    // the server asked how many bytes of updates a connection could take, the data is the uint64_t budget it was given
+    // these come before the tick record of the tick that asked
+    CaptureBudget = 5,
+}NetCaptureDirection;
+
+// The header in front of every record in the file, the message data follows it
+// Everything is in the byte ordering of the machine that made the capture
+typedef struct
+{
+    // nanoseconds since the capture was started
+    uint64_t Timestamp;
+
+    // the length of the message data that follows this header
+    uint32_t Length;
+
+    // the connection (enet peer id) this message was for
+    uint16_t Connection;
+
+    // a NetCaptureDirection
+    uint8_t Direction;
+
+    // the first byte of the message, this is the NetworkCommands value, or 0 if there is no message
+    uint8_t Command;
+}NetCaptureRecord;
+
+// A capture that is being written
+typedef struct NetCapture NetCapture;
+
+// A capture that has been mapped into memory to be read back
+typedef struct NetCaptureReader NetCaptureReader;
+
+// get a monotonic time in nanoseconds, used for capture timestamps and for timing replays
+uint64_t NetCaptureClock();
+
+// Open a capture file for writing, an existing file with the same name is replaced
+// returns NULL if the file could not be opened
+NetCapture* NetCaptureOpen(const char* fileName);
+
+// write anything that is buffered out to the file
+void NetCaptureFlush(NetCapture* capture);
+
+// flush and close a capture file
+void NetCaptureClose(NetCapture* capture);
+
+// Add a record to a capture. data can be NULL if length is 0
+void NetCaptureWrite(NetCapture* capture, uint16_t connection, NetCaptureDirection direction, const uint8_t* data, size_t length);
+
+// Map a capture file into memory so it can be read back
+// returns NULL if the file could not be mapped or is not a capture
+NetCaptureReader* NetCaptureReaderOpen(const char* fileName);
+
+// unmap a capture file
+void NetCaptureReaderClose(NetCaptureReader* reader);
+
+// Go back to the first record in the capture
+void NetCaptureReaderRewind(NetCaptureReader* reader);
+
+// Get the next record from the capture, data points into the mapped file and is valid until the reader is closed
+// returns false when there are no more (complete) records
+bool NetCaptureReaderNext(NetCaptureReader* reader, NetCaptureRecord* record, const uint8_t** data);
@@ -0,0 +1,487 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// implementation of the datagram compressor
+//
+// The block format is the one LZ4 uses: a run of sequences, each a token byte (literal count in the high nibble,
+// match length - 4 in the low nibble, 15 means more length bytes follow), the literals, and a 2 byte match offset.
+// The last sequence only has literals. Offsets can reach back past the start of the block into the dictionary.
+
+#include "compress.h"
+#include "capture.h"
+
+// ensure we are using winsock2 on windows.
+#if (_WIN32_WINNT < 0x0601)
+	#undef _WIN32_WINNT
+    #define _WIN32_WINNT 0x0601
+#endif
+
+// include the network layer from enet (https://github.com/zpl-c/enet)
+// the implementation itself is compiled once in enet.c
+#include "enet.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// matches are at least this long, shorter ones cost more to encode than the literals
+#define MinMatch 4
+
+// the hash table of recent positions, 4096 entries is enough for a 4KB datagram and a 4KB dictionary
+#define HashBits 12
+#define HashSize (1 << HashBits)
+
+// the state of a compressor
+struct NetCompressor
+{
+    // the dictionary followed by the datagram being compressed, so matches can reach back into the dictionary
+    uint8_t Window[NetCompressMaxDictionarySize + NetCompressMaxBlockSize];
+    size_t DictionaryLength;
+
+    // positions in the window by the hash of the 4 bytes there, and the same table holding only the dictionary
+    uint16_t Table[HashSize];
+    uint16_t DictionaryTable[HashSize];
+
+    // the table entries a datagram changed, put back from DictionaryTable afterwards so the next datagram starts clean
+    uint16_t Touched[NetCompressMaxBlockSize];
+
+    // what the compressor did while attached to a host
+    NetCompressStats Stats;
+};
+
+static uint32_t Read32(const uint8_t* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t Hash(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - HashBits);
+}
+
+// put every position of the history into the hash table
+static void HashHistory(const uint8_t* window, size_t length, uint16_t* table)
+{
+    for (size_t position = 0; position + MinMatch <= length; position++)
+        table[Hash(Read32(window + position))] = (uint16_t)position;
+}
+
+// write a length that did not fit in its token nibble
+static uint8_t* WriteLength(uint8_t* output, size_t length)
+{
+    while (length >= 255)
+    {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = (uint8_t)length;
+    return output;
+}
+
+// write one sequence, returns NULL if it does not fit
+static uint8_t* WriteSequence(uint8_t* output, const uint8_t* outputEnd, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+    // worst case size of this sequence
+    size_t needed = 1 + literalLength / 255 + 1 + literalLength + (matchLength > 0 ? 2 + matchLength / 255 + 1 : 0);
+    if (needed > (size_t)(outputEnd - output))
+        return NULL;
+
+    size_t matchCode = matchLength > 0 ? matchLength - MinMatch : 0;
+    uint8_t* token = output++;
+    *token = (uint8_t)(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+    if (literalLength >= 15)
+        output = WriteLength(output, literalLength - 15);
+
+    memcpy(output, literals, literalLength);
+    output += literalLength;
+
+    // the last sequence has no match
+    if (matchLength == 0)
+        return output;
+
+    *output++ = (uint8_t)(offset & 0xFF);
+    *output++ = (uint8_t)(offset >> 8);
+
+    if (matchCode >= 15)
+        output = WriteLength(output, matchCode - 15);
+
+    return output;
+}
+
+// Compress the block in the window behind the dictionary, matches can refer back into the dictionary
+static size_t CompressWindow(NetCompressor* compressor, size_t end, uint8_t* output, size_t outputLimit)
+{
+    const uint8_t* window = compressor->Window;
+    uint16_t* table = compressor->Table;
+    size_t start = compressor->DictionaryLength;
+    size_t touchedCount = 0;
+    size_t written = 0;
+
+    const uint8_t* outputEnd = output + outputLimit;
+    uint8_t* out = output;
+    size_t anchor = start;
+    size_t position = start;
+
+    while (position + MinMatch <= end)
+    {
+        uint32_t value = Read32(window + position);
+        uint32_t hash = Hash(value);
+        size_t candidate = table[hash];
+
+        compressor->Touched[touchedCount++] = (uint16_t)hash;
+        table[hash] = (uint16_t)position;
+
+        // the hash can collide and stale entries can point anywhere, so check the bytes really match
+        if (candidate >= position || Read32(window + candidate) != value)
+        {
+            // the longer we go without a match the faster we skip ahead, incompressible data costs little
+            position += 1 + ((position - anchor) >> 5);
+            continue;
+        }
+
+        size_t length = MinMatch;
+        while (position + length < end && window[candidate + length] == window[position + length])
+            length++;
+
+        out = WriteSequence(out, outputEnd, window + anchor, position - anchor, position - candidate, length);
+        if (out == NULL)
+            break;
+
+        position += length;
+        anchor = position;
+    }
+
+    if (out != NULL)
+        out = WriteSequence(out, outputEnd, window + anchor, end - anchor, 0, 0);
+    if (out != NULL)
+        written = (size_t)(out - output);
+
+    // forget this block's positions, the next one only matches against the dictionary
+    for (size_t i = 0; i < touchedCount; i++)
+        table[compressor->Touched[i]] = compressor->DictionaryTable[compressor->Touched[i]];
+
+    return written;
+}
+
+// read a length that did not fit in its token nibble, returns false if the block ends first
+static bool ReadLength(const uint8_t** input, const uint8_t* inputEnd, size_t* length)
+{
+    uint8_t byte;
+    do
+    {
+        if (*input >= inputEnd)
+            return false;
+
+        byte = *(*input)++;
+        *length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+// decode a block, matches that reach back past the start of the output come from the end of the dictionary
+static size_t Decompress(const uint8_t* dictionary, size_t dictionaryLength, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLimit)
+{
+    const uint8_t* inputEnd = input + inputLength;
+    size_t written = 0;
+
+    while (input < inputEnd)
+    {
+        uint8_t token = *input++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(&input, inputEnd, &literalLength))
+            return 0;
+
+        if (literalLength > (size_t)(inputEnd - input) || literalLength > outputLimit - written)
+            return 0;
+
+        memcpy(output + written, input, literalLength);
+        input += literalLength;
+        written += literalLength;
+
+        // the last sequence ends with its literals
+        if (input == inputEnd)
+            break;
+
+        if (inputEnd - input < 2)
+            return 0;
+
+        size_t offset = (size_t)input[0] | ((size_t)input[1] << 8);
+        input += 2;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(&input, inputEnd, &matchLength))
+            return 0;
+        matchLength += MinMatch;
+
+        if (offset == 0 || offset > written + dictionaryLength || matchLength > outputLimit - written)
+            return 0;
+
+        // the part of the match that is still in the dictionary
+        if (offset > written)
+        {
+            size_t fromDictionary = offset - written;
+            if (fromDictionary > matchLength)
+                fromDictionary = matchLength;
+
+            memcpy(output + written, dictionary + dictionaryLength - (offset - written), fromDictionary);
+            written += fromDictionary;
+            matchLength -= fromDictionary;
+        }
+
+        // matches can overlap what they write (a repeating pattern), so copy forward a byte at a time when they do
+        const uint8_t* source = output + written - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(output + written, source, matchLength);
+        }
+        else
+        {
+            for (size_t i = 0; i < matchLength; i++)
+                output[written + i] = source[i];
+        }
+        written += matchLength;
+    }
+
+    return written;
+}
+
+NetCompressor* NetCompressorCreate(const uint8_t* dictionary, size_t dictionaryLength)
+{
+    NetCompressor* compressor = (NetCompressor*)enet_malloc(sizeof(NetCompressor));
+    if (compressor == NULL)
+        return NULL;
+
+    memset(compressor, 0, sizeof(NetCompressor));
+
+    // only the end of a long dictionary can be reached
+    if (dictionary == NULL)
+        dictionaryLength = 0;
+    if (dictionaryLength > NetCompressMaxDictionarySize)
+    {
+        dictionary += dictionaryLength - NetCompressMaxDictionarySize;
+        dictionaryLength = NetCompressMaxDictionarySize;
+    }
+
+    if (dictionaryLength > 0)
+        memcpy(compressor->Window, dictionary, dictionaryLength);
+    compressor->DictionaryLength = dictionaryLength;
+
+    HashHistory(compressor->Window, dictionaryLength, compressor->DictionaryTable);
+    memcpy(compressor->Table, compressor->DictionaryTable, sizeof(compressor->Table));
+
+    return compressor;
+}
+
+void NetCompressorDestroy(NetCompressor* compressor)
+{
+    enet_free(compressor);
+}
+
+size_t NetCompressorCompress(NetCompressor* compressor, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLimit)
+{
+    if (inputLength > NetCompressMaxBlockSize)
+        return 0;
+
+    memcpy(compressor->Window + compressor->DictionaryLength, input, inputLength);
+    return CompressWindow(compressor, compressor->DictionaryLength + inputLength, output, outputLimit);
+}
+
+size_t NetCompressorDecompress(NetCompressor* compressor, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLimit)
+{
+    return Decompress(compressor->Window, compressor->DictionaryLength, input, inputLength, output, outputLimit);
+}
+
+// enet compressor callbacks
+
+static size_t ENET_CALLBACK CompressDatagram(void* context, const ENetBuffer* inBuffers, size_t inBufferCount, size_t inLimit, enet_uint8* outData, size_t outLimit)
+{
+    NetCompressor* compressor = (NetCompressor*)context;
+    compressor->Stats.Datagrams++;
+    compressor->Stats.BytesIn += inLimit;
+
+    // tiny datagrams are mostly an ack or a single short command, not worth the time
+    if (inLimit < NetCompressMinimumSize || inLimit > NetCompressMaxBlockSize)
+    {
+        compressor->Stats.Skipped++;
+        compressor->Stats.BytesOut += inLimit;
+        return 0;
+    }
+
+    uint64_t start = NetCaptureClock();
+
+    // gather the datagram behind the dictionary
+    size_t end = compressor->DictionaryLength;
+    for (size_t i = 0; i < inBufferCount && end - compressor->DictionaryLength < inLimit; i++)
+    {
+        size_t length = inBuffers[i].dataLength;
+        if (length > compressor->DictionaryLength + inLimit - end)
+            length = compressor->DictionaryLength + inLimit - end;
+
+        memcpy(compressor->Window + end, inBuffers[i].data, length);
+        end += length;
+    }
+
+    size_t length = CompressWindow(compressor, end, outData, outLimit);
+    compressor->Stats.CompressNanoseconds += NetCaptureClock() - start;
+
+    // enet sends it uncompressed unless it got smaller
+    if (length == 0 || length >= inLimit)
+    {
+        compressor->Stats.Skipped++;
+        compressor->Stats.BytesOut += inLimit;
+        return 0;
+    }
+
+    compressor->Stats.BytesOut += length;
+    return length;
+}
+
+static size_t ENET_CALLBACK DecompressDatagram(void* context, const enet_uint8* inData, size_t inLimit, enet_uint8* outData, size_t outLimit)
+{
+    NetCompressor* compressor = (NetCompressor*)context;
+    uint64_t start = NetCaptureClock();
+
+    size_t length = NetCompressorDecompress(compressor, inData, inLimit, outData, outLimit);
+
+    compressor->Stats.Decompressed++;
+    compressor->Stats.BytesDecompressed += length;
+    compressor->Stats.DecompressNanoseconds += NetCaptureClock() - start;
+    return length;
+}
+
+static void ENET_CALLBACK DestroyCompressor(void* context)
+{
+    NetCompressorDestroy((NetCompressor*)context);
+}
+
+bool NetCompressAttach(ENetHost* host, const uint8_t* dictionary, size_t dictionaryLength)
+{
+    NetCompressor* compressor = NetCompressorCreate(dictionary, dictionaryLength);
+    if (compressor == NULL)
+        return false;
+
+    ENetCompressor callbacks;
+    callbacks.context = compressor;
+    callbacks.compress = CompressDatagram;
+    callbacks.decompress = DecompressDatagram;
+    callbacks.destroy = DestroyCompressor;
+    enet_host_compress(host, &callbacks);
+
+    return true;
+}
+
+bool NetCompressGetStats(ENetHost* host, NetCompressStats* stats)
+{
+    if (host->compressor.context == NULL || host->compressor.compress != CompressDatagram)
+        return false;
+
+    *stats = ((NetCompressor*)host->compressor.context)->Stats;
+    return true;
+}
+
+// dictionary training
+
+// the dictionary is built out of segments this long, picked by how common the 8 byte sequences in them are
+#define SegmentSize 32
+#define GramSize 8
+#define GramTableBits 16
+
+static uint32_t HashGram(const uint8_t* data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return (uint32_t)((value * 0x9E3779B97F4A7C15ull) >> (64 - GramTableBits));
+}
+
+size_t NetCompressTrain(const uint8_t* const* samples, const size_t* sampleLengths, size_t sampleCount, uint8_t* dictionary, size_t dictionaryCapacity)
+{
+    // how many samples each 8 byte sequence shows up in, collisions just merge counts
+    uint32_t* counts = (uint32_t*)calloc((size_t)1 << GramTableBits, sizeof(uint32_t));
+    if (counts == NULL)
+        return 0;
+
+    for (size_t i = 0; i < sampleCount; i++)
+    {
+        for (size_t position = 0; position + GramSize <= sampleLengths[i]; position++)
+            counts[HashGram(samples[i] + position)]++;
+    }
+
+    // pick the best scoring segment, then zero the counts it covers so the next pick covers something else
+    // the best segments go at the end of the dictionary, a dictionary that is cut short keeps them
+    size_t written = 0;
+    while (written + GramSize <= dictionaryCapacity)
+    {
+        const uint8_t* best = NULL;
+        size_t bestLength = 0;
+        uint64_t bestScore = 0;
+
+        for (size_t i = 0; i < sampleCount; i++)
+        {
+            for (size_t position = 0; position + GramSize <= sampleLengths[i]; position += GramSize)
+            {
+                size_t length = sampleLengths[i] - position < SegmentSize ? sampleLengths[i] - position : SegmentSize;
+                uint64_t score = 0;
+
+                for (size_t gram = 0; gram + GramSize <= length; gram++)
+                    score += counts[HashGram(samples[i] + position + gram)];
+
+                if (score > bestScore)
+                {
+                    best = samples[i] + position;
+                    bestLength = length;
+                    bestScore = score;
+                }
+            }
+        }
+
+        // nothing repeats any more
+        if (best == NULL || bestScore <= 1)
+            break;
+
+        if (bestLength > dictionaryCapacity - written)
+            bestLength = dictionaryCapacity - written;
+
+        memcpy(dictionary + dictionaryCapacity - written - bestLength, best, bestLength);
+        written += bestLength;
+
+        for (size_t gram = 0; gram + GramSize <= bestLength; gram++)
+            counts[HashGram(best + gram)] = 0;
+    }
+
+    // move the segments to the front
+    memmove(dictionary, dictionary + dictionaryCapacity - written, written);
+
+    free(counts);
+    return written;
+}
@@ -0,0 +1,108 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// Datagram compression for enet.
+// An LZ4 style codec that plugs into an enet host with enet_host_compress, so every datagram the host sends
+// is compressed when that makes it smaller. The window can be primed with a dictionary of typical game traffic
+// so even short datagrams find matches. Both ends of a connection have to attach the compressor with the same dictionary.
+// It keeps counters of what it did, so the CPU cost can be weighed against the bandwidth saved.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// datagrams shorter than this are sent as they are, there is too little in them to win back the cost
+#define NetCompressMinimumSize 24
+
+// the largest dictionary a compressor can use, matches can reach back this far
+#define NetCompressMaxDictionarySize 4096
+
+// What a compressor has done since it was attached
+typedef struct
+{
+    // datagrams that went through the compressor, including the ones it gave up on
+    uint64_t Datagrams;
+
+    // datagrams that were sent as they were, because they were too short or did not get smaller
+    uint64_t Skipped;
+
+    // bytes of the datagrams that went through the compressor, and what they were sent as
+    uint64_t BytesIn;
+    uint64_t BytesOut;
+
+    // time spent compressing
+    uint64_t CompressNanoseconds;
+
+    // datagrams and bytes decompressed, and the time it took
+    uint64_t Decompressed;
+    uint64_t BytesDecompressed;
+    uint64_t DecompressNanoseconds;
+}NetCompressStats;
+
+struct _ENetHost;
+
+// the dictionary the client and server use, trained on captured game traffic (see tools/replay --train)
+extern const uint8_t NetCompressGameDictionary[];
+extern const size_t NetCompressGameDictionarySize;
+
+// the longest block a compressor takes, the largest datagram enet sends
+#define NetCompressMaxBlockSize 4096
+
+// A compressor primed with a dictionary, this is what gets attached to a host
+typedef struct NetCompressor NetCompressor;
+
+// Create a compressor
+// dictionary can be NULL for no dictionary, otherwise it is copied and only the last NetCompressMaxDictionarySize bytes are used
+// returns NULL if it could not be allocated
+NetCompressor* NetCompressorCreate(const uint8_t* dictionary, size_t dictionaryLength);
+
+void NetCompressorDestroy(NetCompressor* compressor);
+
+// Compress a block of up to NetCompressMaxBlockSize bytes
+// returns the compressed length, or 0 if it would not fit in outputLimit
+size_t NetCompressorCompress(NetCompressor* compressor, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLimit);
+
+// Decompress a block made by a compressor with the same dictionary
+// returns the decompressed length, or 0 if the block is corrupt or does not fit in outputLimit
+size_t NetCompressorDecompress(NetCompressor* compressor, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLimit);
+
+// Set up a compressor on an enet host, replacing any compressor it had, the host owns it from then on
+// the dictionary is used the same way as NetCompressorCreate
+// returns false if it could not be allocated
+bool NetCompressAttach(struct _ENetHost* host, const uint8_t* dictionary, size_t dictionaryLength);
+
+// Get the counters for the compressor attached to a host
+// returns false if the host does not have one
+bool NetCompressGetStats(struct _ENetHost* host, NetCompressStats* stats);
+
+// Build a dictionary out of sample messages, the byte sequences that repeat the most across them are kept
+// returns how many bytes were written to dictionary
+size_t NetCompressTrain(const uint8_t* const* samples, const size_t* sampleLengths, size_t sampleCount, uint8_t* dictionary, size_t dictionaryCapacity);
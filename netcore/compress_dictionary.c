@@ -0,0 +1,266 @@
+// the datagram compression dictionary for game traffic
+// generated by tools/replay --train from a capture, regenerate it when the messages change
+
+#include "compress.h"
+
+const uint8_t NetCompressGameDictionary[] =
+{
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x7f, 0x02, 0x71, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x7f, 0x02, 0x71, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x6b, 0x02, 0x67, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x6b, 0x02, 0x67, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x19, 0x02, 0x3e, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x19, 0x02, 0x3e, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x05, 0x02, 0x34, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x05, 0x02, 0x34, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x8b, 0x01, 0xf7, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x8b, 0x01, 0xf7, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x62, 0x01, 0xe3, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x62, 0x01, 0xe3, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x1b, 0x01, 0xbf, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x1b, 0x01, 0xbf, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x2a, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xf0, 0x01, 0x2a, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xa9, 0x01, 0x06, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xa9, 0x01, 0x06, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x81, 0x01, 0xf2, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x81, 0x01, 0xf2, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x00, 0x1a, 0x00, 0x7c, 0x02, 0x3c, 0x00, 0xed, 0xff, 0x02, 0x3b, 0x00, 0x00, 0x00, 0x43,
+    0x01, 0xfd, 0x01, 0x3c, 0x00, 0xf5, 0xff, 0x02, 0x3c, 0x00, 0x00, 0x00, 0x38, 0x01, 0x6a, 0x02,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x57, 0x02, 0x5d, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x57, 0x02, 0x5d, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xa1, 0x00, 0x82, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xa1, 0x00, 0x82, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x4e, 0x00, 0x00, 0x00, 0xaa, 0x04, 0x8b, 0x00, 0xc4,
+    0xff, 0xdc, 0xff, 0x04, 0x53, 0x00, 0x00, 0x00, 0x98, 0x03, 0xb1, 0x00, 0x3c, 0x00, 0xfb, 0xff,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x24, 0x02, 0x44, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x24, 0x02, 0x44, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x77, 0x01, 0xed, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x77, 0x01, 0xed, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x75, 0x02, 0x6c, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x75, 0x02, 0x6c, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0xe6, 0xff, 0xc4, 0xff, 0x02, 0x4d, 0x00, 0x00, 0x00, 0x54, 0x01, 0xc2, 0x02, 0x3c, 0x00, 0x13,
+    0x00, 0x02, 0x4e, 0x00, 0x00, 0x00, 0x1e, 0x04, 0x6e, 0x00, 0x3c, 0x00, 0x0d, 0x00, 0x02, 0x4f,
+    0xef, 0xff, 0x02, 0x23, 0x00, 0x00, 0x00, 0x08, 0x04, 0xc5, 0x01, 0xc4, 0xff, 0xde, 0xff, 0x02,
+    0x24, 0x00, 0x00, 0x00, 0x70, 0x03, 0x4a, 0x01, 0xd1, 0xff, 0x3c, 0x00, 0x02, 0x25, 0x00, 0x00,
+    0x02, 0x13, 0x00, 0x3c, 0x00, 0x02, 0x5e, 0x00, 0x00, 0x00, 0x01, 0x04, 0xbc, 0x01, 0xc4, 0xff,
+    0xf2, 0xff, 0x02, 0x5f, 0x00, 0x00, 0x00, 0x60, 0x00, 0x5a, 0x00, 0x37, 0x00, 0x3c, 0x00, 0x02,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x07, 0x01, 0xb5, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x07, 0x01, 0xb5, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x61, 0x02, 0x62, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x61, 0x02, 0x62, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x38, 0x02, 0x4e, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x38, 0x02, 0x4e, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x0f, 0x02, 0x39, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x0f, 0x02, 0x39, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x4e, 0x01, 0xd9, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x4e, 0x01, 0xd9, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x96, 0x00, 0x7d, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x96, 0x00, 0x7d, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x92, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x92, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0xff, 0x31, 0x00, 0x02, 0x58, 0x00, 0x00, 0x00, 0x8f, 0x03, 0xfd, 0x01, 0xc4, 0xff, 0xef, 0xff,
+    0x02, 0x59, 0x00, 0x00, 0x00, 0x4a, 0x01, 0x6f, 0x00, 0x3c, 0x00, 0x30, 0x00, 0x02, 0x5a, 0x00,
+    0x02, 0x3c, 0x00, 0x01, 0x00, 0x02, 0x2a, 0x00, 0x00, 0x00, 0x81, 0x00, 0xba, 0x00, 0x3c, 0x00,
+    0x23, 0x00, 0x02, 0x2b, 0x00, 0x00, 0x00, 0x7d, 0x01, 0x53, 0x00, 0x06, 0x00, 0x3c, 0x00, 0x02,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x95, 0x01, 0xfc, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x95, 0x01, 0xfc, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00,
+    0x00, 0x00, 0x9e, 0x02, 0x81, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x9e,
+    0x14, 0x00, 0x00, 0x00, 0xff, 0x03, 0x75, 0x02, 0xc4, 0xff, 0xe5, 0xff, 0x02, 0x15, 0x00, 0x00,
+    0x00, 0x71, 0x01, 0x3d, 0x02, 0x1a, 0x00, 0x3c, 0x00, 0x02, 0x16, 0x00, 0x00, 0x00, 0x07, 0x03,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xfa, 0x01, 0x2f, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xfa, 0x01, 0x2f, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x02, 0x26, 0x00, 0x00, 0x00, 0x2e, 0x04, 0x49, 0x01, 0xc4, 0xff, 0x28, 0x00, 0x02, 0x27,
+    0x00, 0x00, 0x00, 0x5a, 0x04, 0x6b, 0x00, 0x18, 0x00, 0x3c, 0x00, 0x02, 0x28, 0x00, 0x00, 0x00,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x3a, 0x01, 0xcf, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x3a, 0x01, 0xcf, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x6a, 0x04, 0x8e, 0x02, 0xc4, 0xff, 0xe7, 0xff, 0x02, 0x49, 0x00, 0x00, 0x00, 0xd3, 0x00, 0x6e,
+    0x00, 0xc4, 0xff, 0x12, 0x00, 0x02, 0x4a, 0x00, 0x00, 0x00, 0x8b, 0x00, 0x89, 0x00, 0x04, 0x00,
+    0x30, 0x00, 0x3c, 0x00, 0x33, 0x00, 0x02, 0x17, 0x00, 0x00, 0x00, 0x61, 0x03, 0xec, 0x00, 0xc4,
+    0xff, 0x1f, 0x00, 0x02, 0x18, 0x00, 0x00, 0x00, 0x53, 0x03, 0xe7, 0x00, 0xc4, 0xff, 0x1d, 0x00,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xbd, 0x01, 0x10, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xbd, 0x01, 0x10, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x25, 0x01, 0xc4, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x25, 0x01, 0xc4, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x02, 0x31, 0x00, 0x00, 0x00, 0xc5, 0x00, 0xc3, 0x00, 0xfb, 0xff, 0x3c, 0x00, 0x02, 0x32, 0x00,
+    0x00, 0x00, 0xbe, 0x03, 0x85, 0x00, 0xf8, 0xff, 0x3c, 0x00, 0x02, 0x33, 0x00, 0x00, 0x00, 0x0f,
+    0x00, 0x46, 0x00, 0x3c, 0x00, 0x28, 0x00, 0x02, 0x1c, 0x00, 0x00, 0x00, 0x3f, 0x04, 0x83, 0x02,
+    0xc4, 0xff, 0xc9, 0xff, 0x02, 0x1d, 0x00, 0x00, 0x00, 0x32, 0x01, 0x65, 0x01, 0x3c, 0x00, 0xf2,
+    0x00, 0x02, 0x0e, 0x00, 0x00, 0x00, 0x93, 0x04, 0x5d, 0x01, 0xc4, 0xff, 0x02, 0x00, 0x02, 0x0f,
+    0x00, 0x00, 0x00, 0xed, 0x02, 0xd6, 0x02, 0x3a, 0x00, 0xc4, 0xff, 0x02, 0x10, 0x00, 0x00, 0x00,
+    0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0x2e, 0x02, 0x49, 0x01, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x2e, 0x02, 0x49, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x02, 0x2e, 0x00, 0x00, 0x00, 0xe4, 0x01, 0xcf, 0x01, 0xc8, 0xff, 0x3c, 0x00, 0x02, 0x2f,
+    0x00, 0x00, 0x00, 0x9d, 0x04, 0x88, 0x01, 0xc4, 0xff, 0xe4, 0xff, 0x02, 0x30, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0xdc, 0x01, 0x20, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00,
+    0x00, 0x19, 0x00, 0x64, 0x00, 0x38, 0xff, 0x00, 0x00, 0x04, 0x06, 0x00, 0x00, 0x00, 0x69, 0x00,
+    0x95, 0x04, 0x23, 0x02, 0xc4, 0xff, 0x26, 0x00, 0x02, 0x39, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x76,
+    0x01, 0x3c, 0x00, 0xe5, 0xff, 0x02, 0x3a, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x7c, 0x02, 0x3c, 0x00,
+    0x2c, 0x02, 0xde, 0x02, 0x1a, 0x00, 0xc4, 0xff, 0x02, 0x11, 0x00, 0x00, 0x00, 0xf8, 0x00, 0xef,
+    0x02, 0x3c, 0x00, 0xe5, 0xff, 0x02, 0x12, 0x00, 0x00, 0x00, 0x80, 0x00, 0x12, 0x01, 0x3c, 0x00,
+    0x34, 0x00, 0x00, 0x00, 0x94, 0x02, 0x5d, 0x02, 0xe0, 0xff, 0xc4, 0xff, 0x02, 0x35, 0x00, 0x00,
+    0x00, 0xb3, 0x01, 0x12, 0x01, 0x03, 0x00, 0x3c, 0x00, 0x02, 0x36, 0x00, 0x00, 0x00, 0x78, 0x03,
+    0x00, 0x00, 0xc6, 0x00, 0x48, 0x01, 0x3c, 0x00, 0xe8, 0xff, 0x02, 0x5b, 0x00, 0x00, 0x00, 0xab,
+    0x02, 0xb9, 0x00, 0xc4, 0xff, 0xfc, 0xff, 0x02, 0x5c, 0x00, 0x00, 0x00, 0xcc, 0x00, 0x1f, 0x02,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xca, 0x00, 0x97, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xca, 0x00, 0x97, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0x00, 0x00, 0x00, 0xdd, 0x04, 0x16, 0x00, 0xc4, 0xff, 0x29, 0x00, 0x02, 0x50, 0x00, 0x00, 0x00,
+    0x97, 0x04, 0x31, 0x01, 0xc4, 0xff, 0x27, 0x00, 0x02, 0x51, 0x00, 0x00, 0x00, 0x3c, 0x03, 0x7e,
+    0x00, 0x00, 0x15, 0x00, 0xde, 0x01, 0x3c, 0x00, 0xe8, 0xff, 0x02, 0x43, 0x00, 0x00, 0x00, 0x31,
+    0x04, 0x07, 0x02, 0xc4, 0xff, 0x10, 0x00, 0x02, 0x44, 0x00, 0x00, 0x00, 0x68, 0x02, 0xc6, 0x02,
+    0x55, 0x04, 0x6c, 0x02, 0xc4, 0xff, 0xd9, 0xff, 0x02, 0x09, 0x00, 0x00, 0x00, 0xce, 0x02, 0x81,
+    0x00, 0x03, 0x00, 0x3c, 0x00, 0x02, 0x0a, 0x00, 0x00, 0x00, 0x7b, 0x04, 0x23, 0x00, 0xc4, 0xff,
+    0x3c, 0x00, 0x00, 0x00, 0x38, 0x01, 0x6a, 0x02, 0x17, 0x00, 0xc4, 0xff, 0x02, 0x3d, 0x00, 0x00,
+    0x00, 0x1d, 0x02, 0xd8, 0x00, 0x3c, 0x00, 0xf7, 0xff, 0x02, 0x3e, 0x00, 0x00, 0x00, 0x99, 0x00,
+    0x02, 0x19, 0x00, 0x00, 0x00, 0xf9, 0x03, 0xc2, 0x02, 0xec, 0xff, 0xc4, 0xff, 0x02, 0x1a, 0x00,
+    0x00, 0x00, 0xc9, 0x03, 0x91, 0x02, 0x08, 0x00, 0xc4, 0xff, 0x02, 0x1b, 0x00, 0x00, 0x00, 0xbe,
+    0x10, 0x00, 0x02, 0x0b, 0x00, 0x00, 0x00, 0xa8, 0x03, 0x96, 0x02, 0xc4, 0xff, 0xdc, 0xff, 0x02,
+    0x0c, 0x00, 0x00, 0x00, 0x7f, 0x04, 0xdd, 0x02, 0xc4, 0xff, 0xdc, 0xff, 0x02, 0x0d, 0x00, 0x00,
+    0x49, 0x04, 0x1d, 0x02, 0xc4, 0xff, 0xe0, 0xff, 0x02, 0x21, 0x00, 0x00, 0x00, 0x2d, 0x02, 0xca,
+    0x01, 0x06, 0x00, 0x3c, 0x00, 0x02, 0x22, 0x00, 0x00, 0x00, 0xbd, 0x03, 0x38, 0x02, 0xc4, 0xff,
+    0xff, 0x02, 0x46, 0x00, 0x00, 0x00, 0x3d, 0x02, 0xc8, 0x00, 0x3c, 0x00, 0x35, 0x00, 0x02, 0x47,
+    0x00, 0x00, 0x00, 0xf2, 0x02, 0x41, 0x01, 0x09, 0x00, 0x3c, 0x00, 0x02, 0x48, 0x00, 0x00, 0x00,
+    0x00, 0x32, 0x01, 0x65, 0x01, 0x3c, 0x00, 0xf2, 0xff, 0x02, 0x1e, 0x00, 0x00, 0x00, 0x1c, 0x01,
+    0x06, 0x01, 0x23, 0x00, 0x3c, 0x00, 0x02, 0x1f, 0x00, 0x00, 0x00, 0xc8, 0x03, 0x4b, 0x02, 0x3c,
+    0x02, 0x65, 0x00, 0x00, 0x00, 0xbb, 0x04, 0x06, 0x03, 0xc4, 0xff, 0xde, 0xff, 0x02, 0x66, 0x00,
+    0x00, 0x00, 0x2c, 0x00, 0x9e, 0x01, 0x3c, 0x00, 0xf5, 0xff, 0x02, 0x67, 0x00, 0x00, 0x00, 0x1f,
+    0x00, 0x00, 0x64, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x64,
+    0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x64, 0x00,
+    0x00, 0xe5, 0x03, 0x28, 0x00, 0xc4, 0xff, 0x22, 0x00, 0x02, 0x56, 0x00, 0x00, 0x00, 0x2e, 0x03,
+    0x40, 0x00, 0xc4, 0xff, 0x2d, 0x00, 0x02, 0x57, 0x00, 0x00, 0x00, 0x81, 0x01, 0x76, 0x01, 0xc4,
+    0xe0, 0xff, 0xc4, 0xff, 0x02, 0x61, 0x00, 0x00, 0x00, 0x25, 0x02, 0x38, 0x02, 0x3c, 0x00, 0xc5,
+    0xff, 0x02, 0x62, 0x00, 0x00, 0x00, 0x85, 0x01, 0xf5, 0x02, 0x20, 0x00, 0xc4, 0xff, 0x02, 0x63,
+    0x3c, 0x00, 0x02, 0x4b, 0x00, 0x00, 0x00, 0xc3, 0x04, 0xe5, 0x02, 0xc4, 0xff, 0xf7, 0xff, 0x02,
+    0x4c, 0x00, 0x00, 0x00, 0x85, 0x04, 0x58, 0x02, 0xe6, 0xff, 0xc4, 0xff, 0x02, 0x4d, 0x00, 0x00,
+    0x68, 0x00, 0x00, 0x00, 0xeb, 0x02, 0x0e, 0x01, 0xc4, 0xff, 0xf9, 0xff, 0x02, 0x69, 0x00, 0x00,
+    0x00, 0x2e, 0x03, 0xe1, 0x00, 0xcd, 0xff, 0xc4, 0xff, 0x02, 0x6a, 0x00, 0x00, 0x00, 0x2f, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x8b, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xb2,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x58, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x58, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x4d,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2f, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x2f, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xfa,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x9f,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe8, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xe8, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x6c,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xba, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xba, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x11,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb0, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xb0, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xfd,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xf2, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x81,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x49, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x2e,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa6, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xa6, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xe8,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x77, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x77, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x8a,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x86, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x86, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xa8,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x71, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x71, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x7f,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x34, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x05,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2a, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x2a, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xf0,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x20, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xdc,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x15, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xc7,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xed, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xed, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x77,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xb5, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x07,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x73, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x45, 0x00, 0x73, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x82,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x4f, 0x00, 0x6e, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x4f, 0x00, 0x6e, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x78,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x3b, 0x00, 0x78, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x3b, 0x00, 0x78, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x8c,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4e, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4e, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x97, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x97, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xca,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xbd,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x67, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x67, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x6b,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x25, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x25, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xe6,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd9, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xd9, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x4e,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc4, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xc4, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x25,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x44, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x24,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xa9,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xbf, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x1b,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xca, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xca, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x30,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x59, 0x00, 0x69, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x59, 0x00, 0x69, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x6e,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf7, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xf7, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x8b,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xab, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xab, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xf2,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x31, 0x00, 0x7d, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x31, 0x00, 0x7d, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x96,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6c, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x6c, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x75,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd4, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xd4, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x44,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5d, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x5d, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x57,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xde, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xde, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x49, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xcf, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xcf, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x3a,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x87, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x1c, 0x00, 0x87, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xab,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x07, 0x00, 0x92, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x92, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe3, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xe3, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x62,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9c, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00,
+    0x00, 0x00, 0xd4, 0x00, 0x9c, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xd4,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3e, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x19,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x06, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0xc7, 0x01, 0x15, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00,
+    0x00, 0x2e, 0x00, 0x64, 0x00, 0x38, 0xff, 0x00, 0x00, 0x04, 0x07, 0x00, 0x00, 0x00, 0x64, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0xd2, 0x01, 0x1b, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x04, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x1b, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x3a, 0x00, 0x00, 0x00, 0x88, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x26, 0x00, 0x82, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x26, 0x00, 0x82, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xa1,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x53, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x06, 0x00, 0x00,
+    0x00, 0x63, 0x00, 0x75, 0x00, 0x38, 0xff, 0xc8, 0x00, 0x04, 0x07, 0x00, 0x00, 0x00, 0x64, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x01, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00,
+    0x00, 0x00, 0x94, 0x02, 0x7c, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x94,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x06, 0x00,
+    0x00, 0x00, 0x5e, 0x00, 0x95, 0x00, 0xc8, 0x00, 0x38, 0xff, 0x04, 0x07, 0x00, 0x00, 0x00, 0x64,
+    0x04, 0x05, 0x00, 0x00, 0x00, 0x39, 0x00, 0x64, 0x00, 0x38, 0xff, 0x00, 0x00, 0x04, 0x06, 0x00,
+    0x00, 0x00, 0x6a, 0x00, 0x89, 0x00, 0xc8, 0x00, 0xc8, 0x00, 0x04, 0x07, 0x00, 0x00, 0x00, 0x64,
+    0x00, 0x00, 0x00, 0x05, 0x64, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x64, 0x00, 0x64,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x64, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x64,
+    0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xb5, 0x00, 0x8c, 0x00, 0xc8, 0x00,
+    0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x12, 0x00, 0x8c, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04,
+    0x00, 0x31, 0x00, 0x64, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x04, 0x06, 0x00, 0x00, 0x00, 0x62, 0x00,
+    0x89, 0x00, 0x38, 0xff, 0x38, 0xff, 0x04, 0x07, 0x00, 0x00, 0x00, 0x64, 0x00, 0x64, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xa1, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xde,
+    0x00, 0xa1, 0x00, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa1, 0x00,
+    0x01, 0xc8, 0x00, 0x64, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x01, 0x38, 0xff,
+    0x64, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0xb3, 0x01, 0x0b, 0x01, 0xc8, 0x00, 0x64, 0x00, 0x04,
+    0xe3, 0x00, 0x38, 0xff, 0x64, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x64, 0x00, 0x64, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x04, 0x07, 0x00, 0x00, 0x00, 0x64, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const size_t NetCompressGameDictionarySize = sizeof(NetCompressGameDictionary);
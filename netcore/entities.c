@@ -0,0 +1,298 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// implementation of the entity store
+
+#include "entities.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// pick the vector instructions, SSE2 is part of every x64 CPU and NEON of every 64 bit ARM one
+#if !defined(NET_ENTITIES_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define NET_ENTITIES_SSE2
+    #include <emmintrin.h>
+#elif !defined(NET_ENTITIES_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+    #define NET_ENTITIES_NEON
+    #include <arm_neon.h>
+#endif
+
+NetEntityStore* NetEntityStoreCreate(int capacity)
+{
+    if (capacity <= 0)
+        return NULL;
+
+    // pad to whole lanes so the passes never need a tail loop, the padding slots are always empty
+    size_t count = ((size_t)capacity + NetEntityLanes - 1) / NetEntityLanes * NetEntityLanes;
+
+    // one allocation for the store and every array, the arrays start on 16 bytes and the doubles go first so everything stays aligned
+    size_t header = (sizeof(NetEntityStore) + 15) & ~(size_t)15;
+    size_t size = header + count * (sizeof(double) + sizeof(uint32_t) + sizeof(float) * 6);
+    NetEntityStore* store = (NetEntityStore*)calloc(1, size);
+    if (store == NULL)
+        return NULL;
+
+    uint8_t* arrays = (uint8_t*)store + header;
+    store->UpdateTime = (double*)arrays;
+    arrays += count * sizeof(double);
+
+    store->Flags = (uint32_t*)arrays;
+    arrays += count * sizeof(uint32_t);
+
+    float** floats[] = { &store->X, &store->Y, &store->DX, &store->DY, &store->ExtrapolatedX, &store->ExtrapolatedY };
+    for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++)
+    {
+        *floats[i] = (float*)arrays;
+        arrays += count * sizeof(float);
+    }
+
+    store->Capacity = (int)count;
+    return store;
+}
+
+NetEntityStore* NetEntityStoreResize(NetEntityStore* store, int capacity)
+{
+    NetEntityStore* resized = NetEntityStoreCreate(capacity);
+    if (resized == NULL)
+        return NULL;
+
+    // the slots past the old capacity are already empty, so only the old ones are copied
+    size_t count = (size_t)(store->Capacity < resized->Capacity ? store->Capacity : resized->Capacity);
+    memcpy(resized->UpdateTime, store->UpdateTime, count * sizeof(double));
+    memcpy(resized->Flags, store->Flags, count * sizeof(uint32_t));
+    memcpy(resized->X, store->X, count * sizeof(float));
+    memcpy(resized->Y, store->Y, count * sizeof(float));
+    memcpy(resized->DX, store->DX, count * sizeof(float));
+    memcpy(resized->DY, store->DY, count * sizeof(float));
+    memcpy(resized->ExtrapolatedX, store->ExtrapolatedX, count * sizeof(float));
+    memcpy(resized->ExtrapolatedY, store->ExtrapolatedY, count * sizeof(float));
+
+    NetEntityStoreDestroy(store);
+    return resized;
+}
+
+void NetEntityStoreDestroy(NetEntityStore* store)
+{
+    free(store);
+}
+
+void NetEntityClear(NetEntityStore* store, int id)
+{
+    store->Flags[id] = 0;
+    store->X[id] = store->Y[id] = 0;
+    store->DX[id] = store->DY[id] = 0;
+    store->UpdateTime[id] = 0;
+    store->ExtrapolatedX[id] = store->ExtrapolatedY[id] = 0;
+}
+
+#if defined(NET_ENTITIES_SSE2)
+
+// all bits set in the lanes of the entities that have a flag
+static inline __m128 FlagMask(const NetEntityStore* store, int i, uint32_t flag)
+{
+    __m128i bit = _mm_set1_epi32((int)flag);
+    __m128i flags = _mm_loadu_si128((const __m128i*)(store->Flags + i));
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(flags, bit), bit));
+}
+
+// a where the mask is set, b everywhere else
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+void NetEntityIntegrate(NetEntityStore* store, float deltaT)
+{
+    __m128 step = _mm_set1_ps(deltaT);
+    for (int i = 0; i < store->Capacity; i += NetEntityLanes)
+    {
+        __m128 mask = FlagMask(store, i, EntityIntegrated);
+        __m128 x = _mm_loadu_ps(store->X + i);
+        __m128 y = _mm_loadu_ps(store->Y + i);
+
+        x = Select(mask, _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(store->DX + i), step)), x);
+        y = Select(mask, _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(store->DY + i), step)), y);
+
+        _mm_storeu_ps(store->X + i, x);
+        _mm_storeu_ps(store->Y + i, y);
+    }
+}
+
+void NetEntityClamp(NetEntityStore* store, float minX, float minY, float maxX, float maxY)
+{
+    __m128 lowX = _mm_set1_ps(minX), lowY = _mm_set1_ps(minY);
+    __m128 highX = _mm_set1_ps(maxX), highY = _mm_set1_ps(maxY);
+    for (int i = 0; i < store->Capacity; i += NetEntityLanes)
+    {
+        __m128 mask = FlagMask(store, i, EntityIntegrated);
+        __m128 x = _mm_loadu_ps(store->X + i);
+        __m128 y = _mm_loadu_ps(store->Y + i);
+
+        x = Select(mask, _mm_min_ps(_mm_max_ps(x, lowX), highX), x);
+        y = Select(mask, _mm_min_ps(_mm_max_ps(y, lowY), highY), y);
+
+        _mm_storeu_ps(store->X + i, x);
+        _mm_storeu_ps(store->Y + i, y);
+    }
+}
+
+void NetEntityExtrapolate(NetEntityStore* store, double now)
+{
+    __m128d time = _mm_set1_pd(now);
+    for (int i = 0; i < store->Capacity; i += NetEntityLanes)
+    {
+        __m128 mask = FlagMask(store, i, EntityExtrapolated);
+
+        // the time since the last update is taken in double precision like the times themselves, then narrowed
+        __m128 low = _mm_cvtpd_ps(_mm_sub_pd(time, _mm_loadu_pd(store->UpdateTime + i)));
+        __m128 high = _mm_cvtpd_ps(_mm_sub_pd(time, _mm_loadu_pd(store->UpdateTime + i + 2)));
+        __m128 delta = _mm_movelh_ps(low, high);
+
+        __m128 x = _mm_add_ps(_mm_loadu_ps(store->X + i), _mm_mul_ps(_mm_loadu_ps(store->DX + i), delta));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(store->Y + i), _mm_mul_ps(_mm_loadu_ps(store->DY + i), delta));
+
+        _mm_storeu_ps(store->ExtrapolatedX + i, Select(mask, x, _mm_loadu_ps(store->ExtrapolatedX + i)));
+        _mm_storeu_ps(store->ExtrapolatedY + i, Select(mask, y, _mm_loadu_ps(store->ExtrapolatedY + i)));
+    }
+}
+
+#elif defined(NET_ENTITIES_NEON)
+
+// all bits set in the lanes of the entities that have a flag
+static inline uint32x4_t FlagMask(const NetEntityStore* store, int i, uint32_t flag)
+{
+    return vtstq_u32(vld1q_u32(store->Flags + i), vdupq_n_u32(flag));
+}
+
+void NetEntityIntegrate(NetEntityStore* store, float deltaT)
+{
+    float32x4_t step = vdupq_n_f32(deltaT);
+    for (int i = 0; i < store->Capacity; i += NetEntityLanes)
+    {
+        uint32x4_t mask = FlagMask(store, i, EntityIntegrated);
+        float32x4_t x = vld1q_f32(store->X + i);
+        float32x4_t y = vld1q_f32(store->Y + i);
+
+        // multiply then add, a fused multiply add would round differently from the other builds
+        x = vbslq_f32(mask, vaddq_f32(x, vmulq_f32(vld1q_f32(store->DX + i), step)), x);
+        y = vbslq_f32(mask, vaddq_f32(y, vmulq_f32(vld1q_f32(store->DY + i), step)), y);
+
+        vst1q_f32(store->X + i, x);
+        vst1q_f32(store->Y + i, y);
+    }
+}
+
+void NetEntityClamp(NetEntityStore* store, float minX, float minY, float maxX, float maxY)
+{
+    float32x4_t lowX = vdupq_n_f32(minX), lowY = vdupq_n_f32(minY);
+    float32x4_t highX = vdupq_n_f32(maxX), highY = vdupq_n_f32(maxY);
+    for (int i = 0; i < store->Capacity; i += NetEntityLanes)
+    {
+        uint32x4_t mask = FlagMask(store, i, EntityIntegrated);
+        float32x4_t x = vld1q_f32(store->X + i);
+        float32x4_t y = vld1q_f32(store->Y + i);
+
+        x = vbslq_f32(mask, vminq_f32(vmaxq_f32(x, lowX), highX), x);
+        y = vbslq_f32(mask, vminq_f32(vmaxq_f32(y, lowY), highY), y);
+
+        vst1q_f32(store->X + i, x);
+        vst1q_f32(store->Y + i, y);
+    }
+}
+
+void NetEntityExtrapolate(NetEntityStore* store, double now)
+{
+    float64x2_t time = vdupq_n_f64(now);
+    for (int i = 0; i < store->Capacity; i += NetEntityLanes)
+    {
+        uint32x4_t mask = FlagMask(store, i, EntityExtrapolated);
+
+        // the time since the last update is taken in double precision like the times themselves, then narrowed
+        float32x2_t low = vcvt_f32_f64(vsubq_f64(time, vld1q_f64(store->UpdateTime + i)));
+        float32x2_t high = vcvt_f32_f64(vsubq_f64(time, vld1q_f64(store->UpdateTime + i + 2)));
+        float32x4_t delta = vcombine_f32(low, high);
+
+        float32x4_t x = vaddq_f32(vld1q_f32(store->X + i), vmulq_f32(vld1q_f32(store->DX + i), delta));
+        float32x4_t y = vaddq_f32(vld1q_f32(store->Y + i), vmulq_f32(vld1q_f32(store->DY + i), delta));
+
+        vst1q_f32(store->ExtrapolatedX + i, vbslq_f32(mask, x, vld1q_f32(store->ExtrapolatedX + i)));
+        vst1q_f32(store->ExtrapolatedY + i, vbslq_f32(mask, y, vld1q_f32(store->ExtrapolatedY + i)));
+    }
+}
+
+#else
+
+void NetEntityIntegrate(NetEntityStore* store, float deltaT)
+{
+    for (int i = 0; i < store->Capacity; i++)
+    {
+        if (!(store->Flags[i] & EntityIntegrated))
+            continue;
+
+        store->X[i] += store->DX[i] * deltaT;
+        store->Y[i] += store->DY[i] * deltaT;
+    }
+}
+
+void NetEntityClamp(NetEntityStore* store, float minX, float minY, float maxX, float maxY)
+{
+    for (int i = 0; i < store->Capacity; i++)
+    {
+        if (!(store->Flags[i] & EntityIntegrated))
+            continue;
+
+        if (store->X[i] < minX)
+            store->X[i] = minX;
+
+        if (store->Y[i] < minY)
+            store->Y[i] = minY;
+
+        if (store->X[i] > maxX)
+            store->X[i] = maxX;
+
+        if (store->Y[i] > maxY)
+            store->Y[i] = maxY;
+    }
+}
+
+void NetEntityExtrapolate(NetEntityStore* store, double now)
+{
+    for (int i = 0; i < store->Capacity; i++)
+    {
+        if (!(store->Flags[i] & EntityExtrapolated))
+            continue;
+
+        float delta = (float)(now - store->UpdateTime[i]);
+        store->ExtrapolatedX[i] = store->X[i] + store->DX[i] * delta;
+        store->ExtrapolatedY[i] = store->Y[i] + store->DY[i] * delta;
+    }
+}
+
+#endif
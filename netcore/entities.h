@@ -0,0 +1,106 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// The entity store.
+// Everything that moves on the field (the players and the server's NPCs) is kept as a structure of arrays, one array per field,
+// instead of an array of structs that mix flags and positions. The per tick passes that move, clamp and extrapolate
+// entities touch only the arrays they need and run over four entities at a time with SSE2 or NEON.
+// Define NET_ENTITIES_NO_SIMD to use the plain loops.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// the passes work on this many entities at once, the arrays are padded to a multiple of it
+#define NetEntityLanes 4
+
+// what an entity slot holds, the passes check these to pick the entities they work on
+typedef enum
+{
+    // the slot is in use
+    EntityActive = 1 << 0,
+
+    // moved along its direction and kept inside the field by the integrate and clamp passes (a player we simulate ourselves)
+    EntityIntegrated = 1 << 1,
+
+    // the position is the last one we were told about, and the extrapolate pass moves it forward along its direction (a player someone else simulates)
+    EntityExtrapolated = 1 << 2,
+
+    // the server has a position for it that the other players have been told about
+    EntityValidPosition = 1 << 3,
+}NetEntityFlags;
+
+// The entities, each field has its own array indexed by the entity id
+typedef struct
+{
+    // how many entities there are room for, the arrays have this many entries
+    int Capacity;
+
+    // a mix of NetEntityFlags, 0 for an empty slot
+    uint32_t* Flags;
+
+    // the position on the field
+    float* X;
+    float* Y;
+
+    // the direction it is going, in units per second
+    float* DX;
+    float* DY;
+
+    // when the position was last set
+    double* UpdateTime;
+
+    // where the extrapolate pass thinks the entity is now
+    float* ExtrapolatedX;
+    float* ExtrapolatedY;
+}NetEntityStore;
+
+// create a store with room for at least capacity entities, all slots empty
+// returns NULL if it could not be allocated
+NetEntityStore* NetEntityStoreCreate(int capacity);
+
+// move a store into one with room for at least capacity entities, the entities that fit keep their slots and the new slots are empty
+// the old store is freed and the new one returned, or NULL with the old store untouched if it could not be allocated
+NetEntityStore* NetEntityStoreResize(NetEntityStore* store, int capacity);
+
+// free a store and all its arrays
+void NetEntityStoreDestroy(NetEntityStore* store);
+
+// empty one slot, all its fields go back to 0
+void NetEntityClear(NetEntityStore* store, int id);
+
+// move every EntityIntegrated entity along its direction for deltaT seconds
+void NetEntityIntegrate(NetEntityStore* store, float deltaT);
+
+// keep every EntityIntegrated entity inside a box
+void NetEntityClamp(NetEntityStore* store, float minX, float minY, float maxX, float maxY);
+
+// set the extrapolated position of every EntityExtrapolated entity from its last position, its direction and how long ago that was
+void NetEntityExtrapolate(NetEntityStore* store, double now);
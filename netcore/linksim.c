@@ -0,0 +1,380 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// implementation of the network condition simulator
+
+#include "linksim.h"
+
+// ensure we are using winsock2 on windows.
+#if (_WIN32_WINNT < 0x0601)
+	#undef _WIN32_WINNT
+    #define _WIN32_WINNT 0x0601
+#endif
+
+// include the network layer from enet (https://github.com/zpl-c/enet)
+// the implementation itself is compiled once in enet.c
+#include "enet.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// a datagram waiting for its time to be sent
+typedef struct
+{
+    // when it goes out, in enet_time_get_us microseconds
+    uint64_t Due;
+
+    // datagrams due at the same time go out in the order they were queued
+    uint64_t Order;
+
+    ENetAddress Address;
+    size_t Length;
+    uint8_t Data[];
+}HeldDatagram;
+
+// the state of a simulator
+struct NetLinkSim
+{
+    ENetHost* Host;
+    NetLinkConditions Conditions;
+    NetLinkStats Stats;
+
+    // generators for the outgoing and incoming decisions, kept apart so the outgoing ones
+    // don't depend on how sends and receives happened to interleave
+    uint64_t Random;
+    uint64_t InboundRandom;
+
+    // when the link has finished putting everything queued so far on the wire, with a bandwidth
+    uint64_t LinkFree;
+
+    // held datagrams, a min heap on Due then Order
+    HeldDatagram** Held;
+    size_t HeldCount;
+    size_t HeldCapacity;
+    uint64_t NextOrder;
+};
+
+// splitmix64, small and good enough to pick which datagrams to mangle
+static uint64_t NextRandom(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// a number from 0 up to but not including 1
+static float RandomUnit(uint64_t* state)
+{
+    return (float)(NextRandom(state) >> 40) / (float)(1 << 24);
+}
+
+static bool HeldBefore(const HeldDatagram* a, const HeldDatagram* b)
+{
+    return a->Due < b->Due || (a->Due == b->Due && a->Order < b->Order);
+}
+
+static bool PushHeld(NetLinkSim* sim, HeldDatagram* datagram)
+{
+    if (sim->HeldCount == sim->HeldCapacity)
+    {
+        size_t capacity = sim->HeldCapacity ? sim->HeldCapacity * 2 : 64;
+        HeldDatagram** held = (HeldDatagram**)realloc(sim->Held, capacity * sizeof(HeldDatagram*));
+        if (held == NULL)
+            return false;
+
+        sim->Held = held;
+        sim->HeldCapacity = capacity;
+    }
+
+    // sift up
+    size_t index = sim->HeldCount++;
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!HeldBefore(datagram, sim->Held[parent]))
+            break;
+
+        sim->Held[index] = sim->Held[parent];
+        index = parent;
+    }
+
+    sim->Held[index] = datagram;
+    return true;
+}
+
+static HeldDatagram* PopHeld(NetLinkSim* sim)
+{
+    HeldDatagram* first = sim->Held[0];
+    HeldDatagram* last = sim->Held[--sim->HeldCount];
+
+    // sift the last one down from the top
+    size_t index = 0;
+    for (;;)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= sim->HeldCount)
+            break;
+
+        if (child + 1 < sim->HeldCount && HeldBefore(sim->Held[child + 1], sim->Held[child]))
+            child++;
+
+        if (!HeldBefore(sim->Held[child], last))
+            break;
+
+        sim->Held[index] = sim->Held[child];
+        index = child;
+    }
+
+    if (sim->HeldCount > 0)
+        sim->Held[index] = last;
+
+    return first;
+}
+
+// copy a datagram out of the host's buffers and hold it until due
+static void HoldDatagram(NetLinkSim* sim, const ENetAddress* address, const ENetBuffer* buffers, size_t bufferCount, size_t length, uint64_t due)
+{
+    HeldDatagram* datagram = (HeldDatagram*)malloc(sizeof(HeldDatagram) + length);
+    if (datagram == NULL)
+        return;
+
+    datagram->Due = due;
+    datagram->Order = sim->NextOrder++;
+    datagram->Address = *address;
+    datagram->Length = length;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < bufferCount; i++)
+    {
+        memcpy(datagram->Data + offset, buffers[i].data, buffers[i].dataLength);
+        offset += buffers[i].dataLength;
+    }
+
+    if (!PushHeld(sim, datagram))
+        free(datagram);
+}
+
+// send everything due by now, or everything when now is UINT64_MAX
+static void SendDue(NetLinkSim* sim, uint64_t now)
+{
+    while (sim->HeldCount > 0 && sim->Held[0]->Due <= now)
+    {
+        HeldDatagram* datagram = PopHeld(sim);
+        enet_host_send_raw(sim->Host, &datagram->Address, datagram->Data, datagram->Length);
+        free(datagram);
+    }
+}
+
+static int ENET_CALLBACK SendIntercept(ENetHost* host, const ENetAddress* address, const ENetBuffer* buffers, size_t bufferCount, size_t dataLength)
+{
+    NetLinkSim* sim = (NetLinkSim*)host->interceptContext;
+    const NetLinkConditions* conditions = &sim->Conditions;
+    uint64_t now = enet_time_get_us();
+
+    sim->Stats.Sent++;
+
+    // every datagram takes the same number of draws whatever happens to it, so the decisions stay in step with the traffic
+    bool lost = RandomUnit(&sim->Random) < conditions->Loss;
+    bool duplicate = RandomUnit(&sim->Random) < conditions->Duplicate;
+    bool reorder = RandomUnit(&sim->Random) < conditions->Reorder;
+    uint64_t jitter = NextRandom(&sim->Random) % ((uint64_t)conditions->Jitter + 1);
+    uint64_t duplicateJitter = NextRandom(&sim->Random) % ((uint64_t)conditions->Jitter + 1);
+
+    if (lost)
+    {
+        sim->Stats.Lost++;
+        SendDue(sim, now);
+        return 1;
+    }
+
+    // with a bandwidth the datagram waits for the ones queued before it to go out
+    uint64_t departure = now;
+    if (conditions->Bandwidth != 0)
+    {
+        if (sim->LinkFree > departure)
+            departure = sim->LinkFree;
+
+        if (conditions->QueueLimit != 0 && departure - now > (uint64_t)conditions->QueueLimit * 1000)
+        {
+            sim->Stats.Overflowed++;
+            SendDue(sim, now);
+            return 1;
+        }
+
+        departure += (uint64_t)dataLength * 1000000 / conditions->Bandwidth;
+        sim->LinkFree = departure;
+    }
+
+    uint64_t due = departure + ((uint64_t)conditions->Latency + jitter) * 1000;
+    if (reorder)
+    {
+        due += (uint64_t)conditions->ReorderDelay * 1000;
+        sim->Stats.Reordered++;
+    }
+
+    HoldDatagram(sim, address, buffers, bufferCount, dataLength, due);
+
+    if (duplicate)
+    {
+        HoldDatagram(sim, address, buffers, bufferCount, dataLength, departure + ((uint64_t)conditions->Latency + duplicateJitter) * 1000);
+        sim->Stats.Duplicated++;
+    }
+
+    SendDue(sim, now);
+    return 1;
+}
+
+static int ENET_CALLBACK ReceiveIntercept(ENetHost* host, void* event)
+{
+    NetLinkSim* sim = (NetLinkSim*)host->interceptContext;
+    (void)event;
+
+    sim->Stats.Received++;
+    SendDue(sim, enet_time_get_us());
+
+    if (RandomUnit(&sim->InboundRandom) < sim->Conditions.InboundLoss)
+    {
+        sim->Stats.InboundLost++;
+        return 1;
+    }
+
+    return 0;
+}
+
+bool NetLinkParse(const char* text, NetLinkConditions* conditions)
+{
+    while (*text != '\0')
+    {
+        // keys and values are separated by commas or spaces
+        while (*text == ',' || *text == ' ')
+            text++;
+
+        if (*text == '\0')
+            break;
+
+        const char* key = text;
+        while (*text != '=' && *text != ',' && *text != ' ' && *text != '\0')
+            text++;
+
+        size_t keyLength = (size_t)(text - key);
+        if (*text != '=')
+            return false;
+
+        char* end = NULL;
+        double value = strtod(text + 1, &end);
+        if (end == text + 1 || value < 0)
+            return false;
+
+        text = end;
+
+#define IsKey(name) (keyLength == sizeof(name) - 1 && strncmp(key, name, keyLength) == 0)
+        if (IsKey("latency"))
+            conditions->Latency = (uint32_t)value;
+        else if (IsKey("jitter"))
+            conditions->Jitter = (uint32_t)value;
+        else if (IsKey("loss"))
+            conditions->Loss = (float)value;
+        else if (IsKey("duplicate"))
+            conditions->Duplicate = (float)value;
+        else if (IsKey("reorder"))
+            conditions->Reorder = (float)value;
+        else if (IsKey("reorderdelay"))
+            conditions->ReorderDelay = (uint32_t)value;
+        else if (IsKey("bandwidth"))
+            conditions->Bandwidth = (uint32_t)value;
+        else if (IsKey("queue"))
+            conditions->QueueLimit = (uint32_t)value;
+        else if (IsKey("inloss"))
+            conditions->InboundLoss = (float)value;
+        else if (IsKey("seed"))
+            conditions->Seed = (uint32_t)value;
+        else
+            return false;
+#undef IsKey
+    }
+
+    return true;
+}
+
+NetLinkSim* NetLinkSimAttach(ENetHost* host, const NetLinkConditions* conditions)
+{
+    NetLinkSim* sim = (NetLinkSim*)malloc(sizeof(NetLinkSim));
+    if (sim == NULL)
+        return NULL;
+
+    memset(sim, 0, sizeof(NetLinkSim));
+    sim->Host = host;
+    sim->Conditions = *conditions;
+    sim->Random = conditions->Seed;
+    sim->InboundRandom = (uint64_t)conditions->Seed ^ 0x5A5A5A5A5A5A5A5Aull;
+
+    host->interceptContext = sim;
+    enet_host_set_intercept(host, ReceiveIntercept);
+    enet_host_set_send_intercept(host, SendIntercept);
+    return sim;
+}
+
+void NetLinkSimDetach(NetLinkSim* sim)
+{
+    if (sim == NULL)
+        return;
+
+    enet_host_set_intercept(sim->Host, NULL);
+    enet_host_set_send_intercept(sim->Host, NULL);
+    sim->Host->interceptContext = NULL;
+
+    // whatever is still on the simulated wire gets delivered, so a last disconnect isn't lost with the simulator
+    SendDue(sim, UINT64_MAX);
+
+    free(sim->Held);
+    free(sim);
+}
+
+uint32_t NetLinkSimUpdate(NetLinkSim* sim, uint32_t maxWait)
+{
+    if (sim == NULL)
+        return maxWait;
+
+    uint64_t now = enet_time_get_us();
+    SendDue(sim, now);
+
+    if (sim->HeldCount == 0)
+        return maxWait;
+
+    // round up, waking before the datagram is due would just wait again
+    uint64_t wait = (sim->Held[0]->Due - now + 999) / 1000;
+    return wait < maxWait ? (uint32_t)wait : maxWait;
+}
+
+void NetLinkSimGetStats(NetLinkSim* sim, NetLinkStats* stats)
+{
+    *stats = sim->Stats;
+}
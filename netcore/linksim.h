@@ -0,0 +1,117 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// Network condition simulator.
+// Sits on an enet host through its receive and send intercepts and makes a loopback link behave like a real one:
+// latency, jitter, loss, duplication, reordering and a bandwidth cap with a queue that overflows.
+// Every random decision comes from a seeded generator and only depends on the order of the datagrams,
+// so a run with the same seed and the same traffic drops, duplicates and reorders the same datagrams.
+// Datagrams are delayed on the way out, so to impair both directions attach a simulator at both ends.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// What the simulated link does to datagrams
+typedef struct
+{
+    // milliseconds every outgoing datagram is delayed
+    uint32_t Latency;
+
+    // each datagram is delayed up to this many milliseconds more, picked at random, so datagrams can pass each other
+    uint32_t Jitter;
+
+    // chance from 0 to 1 that an outgoing datagram is dropped
+    float Loss;
+
+    // chance from 0 to 1 that a datagram that gets through is sent twice
+    float Duplicate;
+
+    // chance from 0 to 1 that a datagram is held back ReorderDelay milliseconds, so the ones after it arrive first
+    float Reorder;
+    uint32_t ReorderDelay;
+
+    // bytes per second the link carries, 0 for no limit
+    // datagrams queue up behind each other at this rate
+    uint32_t Bandwidth;
+
+    // milliseconds of data the link queues at its bandwidth, datagrams arriving at a fuller queue are dropped, 0 for no limit
+    uint32_t QueueLimit;
+
+    // chance from 0 to 1 that a received datagram is dropped before enet sees it
+    float InboundLoss;
+
+    // seed for the random decisions
+    uint32_t Seed;
+}NetLinkConditions;
+
+// What a simulator has done since it was attached
+typedef struct
+{
+    // datagrams the host sent and received through the simulator
+    uint64_t Sent;
+    uint64_t Received;
+
+    // datagrams dropped by Loss, by the queue limit and by InboundLoss
+    uint64_t Lost;
+    uint64_t Overflowed;
+    uint64_t InboundLost;
+
+    // extra copies sent, and datagrams held back to be reordered
+    uint64_t Duplicated;
+    uint64_t Reordered;
+}NetLinkStats;
+
+struct _ENetHost;
+
+typedef struct NetLinkSim NetLinkSim;
+
+// Read conditions from text like "latency=80,jitter=20,loss=0.02"
+// the keys are latency, jitter, loss, duplicate, reorder, reorderdelay, bandwidth, queue, inloss and seed
+// fields that are not named are left as they were
+// returns false if a key is unknown or a value is not a number
+bool NetLinkParse(const char* text, NetLinkConditions* conditions);
+
+// Put a simulator on a host, it takes over the host's intercepts until it is detached
+// returns NULL if it could not be allocated
+NetLinkSim* NetLinkSimAttach(struct _ENetHost* host, const NetLinkConditions* conditions);
+
+// Take a simulator off its host, datagrams it is still holding are sent right away
+// call this before the host is destroyed
+void NetLinkSimDetach(NetLinkSim* sim);
+
+// Send the datagrams whose time has come
+// the simulator also does this whenever the host sends or receives, this is for when the host is idle
+// returns how many milliseconds until the next held datagram is due, at most maxWait
+// a NULL simulator just returns maxWait, so it can be passed as the timeout of enet_host_service
+uint32_t NetLinkSimUpdate(NetLinkSim* sim, uint32_t maxWait);
+
+// Get the counters of a simulator
+void NetLinkSimGetStats(NetLinkSim* sim, NetLinkStats* stats);
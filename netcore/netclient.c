@@ -0,0 +1,807 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// implementation code for the network client
+
+#include "netclient.h"
+#include "compress.h"
+#include "entities.h"
+
+// ensure we are using winsock2 on windows.
+#if (_WIN32_WINNT < 0x0601)
+	#undef _WIN32_WINNT
+    #define _WIN32_WINNT 0x0601
+#endif
+
+// include the network layer from enet (https://github.com/zpl-c/enet)
+// the implementation itself is compiled once in enet.c
+#include "enet.h"
+
+// how long to wait between updates (20 update ticks a second)
+static double InputUpdateInterval = 1.0f / 20.0f;
+
+// All the state for one client connection
+struct NetClient
+{
+    // the player id of this client
+    int LocalPlayerId;
+
+    // the server tick that was current when we were accepted, and when that was
+    // ticks after that are counted on our own clock at ServerTickRate, so we can tell the server which tick we were seeing
+    uint32_t AcceptTick;
+    double AcceptTime;
+
+    // the last player someone tagged, -1 for none, and when we heard about it
+    int TaggedPlayer;
+    double TaggedTime;
+
+    // the enet address we are connected to
+    ENetAddress Address;
+
+    // the server object we are connecting to
+    ENetPeer* Server;
+
+    // the client host we are using, this is the pool's host for pooled clients
+    ENetHost* Host;
+
+    // the pool this client lives in, NULL if the client owns its own host, and its slot there
+    NetClientPool* Pool;
+    int PoolSlot;
+
+    // where we record our traffic, NULL if we are not capturing
+    NetCapture* Capture;
+
+    // the link conditions to simulate on our own host, and the simulator while connected
+    bool SimulateLink;
+    NetLinkConditions LinkConditions;
+    NetLinkSim* Link;
+
+    // time data for the network tick so that we don't spam the server with one update every drawing frame
+
+    // how long in seconds since the last time we sent an update
+    double LastInputSend;
+
+    double LastNow;
+
+    // All possible players, one entity per player id, followed by the NPCs the server has told us about
+    // this is the local simulation that represents the current game state
+    // it includes the current local player and the last known data from all remote players
+    // the client checks this every frame to see where everyone is on the field
+    // the local player is EntityIntegrated so it moves with our input, remote players are EntityExtrapolated from what the server tells us
+    NetEntityStore* Players;
+};
+
+// A set of clients that share one enet host
+struct NetClientPool
+{
+    // the shared host, it has one peer slot per client
+    ENetHost* Host;
+
+    // the clients in the pool, unused slots are NULL
+    NetClient** Clients;
+    int MaxClients;
+
+    // a stack of the unused slots, so adding and removing a client doesn't search the whole pool
+    int* FreeSlots;
+    int FreeCount;
+};
+
+// create a new client that is not connected to anything
+NetClient* NetClientCreate()
+{
+    // startup the network library, enet reference counts this so every client can do it
+    if (enet_initialize() != 0)
+        return NULL;
+
+    NetClient* ctx = (NetClient*)enet_malloc(sizeof(NetClient));
+    if (ctx == NULL)
+    {
+        enet_deinitialize();
+        return NULL;
+    }
+
+    memset(ctx, 0, sizeof(NetClient));
+
+    ctx->Players = NetEntityStoreCreate(MAX_PLAYERS);
+    if (ctx->Players == NULL)
+    {
+        enet_free(ctx);
+        enet_deinitialize();
+        return NULL;
+    }
+
+    ctx->LocalPlayerId = -1;
+    ctx->LastInputSend = -100;
+    ctx->TaggedPlayer = -1;
+    return ctx;
+}
+
+// create a new client that uses the host of a pool
+NetClient* NetClientCreateInPool(NetClientPool* pool)
+{
+    if (pool == NULL)
+        return NULL;
+
+    // the pool is full
+    if (pool->FreeCount == 0)
+        return NULL;
+
+    NetClient* ctx = NetClientCreate();
+    if (ctx == NULL)
+        return NULL;
+
+    // take the free slot on top of the stack
+    int slot = pool->FreeSlots[--pool->FreeCount];
+    ctx->Pool = pool;
+    ctx->PoolSlot = slot;
+    ctx->Host = pool->Host;
+    pool->Clients[slot] = ctx;
+    return ctx;
+}
+
+// disconnect and free a client
+void NetClientDestroy(NetClient* ctx)
+{
+    if (ctx == NULL)
+        return;
+
+    NetClientDisconnect(ctx);
+
+    // give the slot back to the pool
+    if (ctx->Pool != NULL)
+    {
+        ctx->Pool->Clients[ctx->PoolSlot] = NULL;
+        ctx->Pool->FreeSlots[ctx->Pool->FreeCount++] = ctx->PoolSlot;
+    }
+
+    NetEntityStoreDestroy(ctx->Players);
+    enet_free(ctx);
+    enet_deinitialize();
+}
+
+// Connect a client to a server
+bool NetClientConnect(NetClient* ctx, const char* hostName, uint16_t port)
+{
+    // drop any old connection, a reconnect starts from a clean simulation
+    NetClientDisconnect(ctx);
+    for (int i = 0; i < ctx->Players->Capacity; i++)
+        NetEntityClear(ctx->Players, i);
+
+    ctx->LocalPlayerId = -1;
+    ctx->LastInputSend = -100;
+    ctx->TaggedPlayer = -1;
+
+    // create a client that we will use to connect to the server, pooled clients already have one
+    if (ctx->Pool == NULL)
+        ctx->Host = enet_host_create(NULL, 1, 1, 0, 0);
+
+    if (ctx->Host == NULL)
+        return false;
+
+    // the server checksums every datagram, so we have to as well
+    ctx->Host->checksum = enet_crc32;
+
+    // and compresses them with the game dictionary, pooled hosts got their compressor when the pool was made
+    if (ctx->Pool == NULL && !NetCompressAttach(ctx->Host, NetCompressGameDictionary, NetCompressGameDictionarySize))
+        return false;
+
+    // every message is read and destroyed as soon as it arrives, so let enet hand them over without copying
+    if (ctx->Pool == NULL)
+        enet_host_zero_copy(ctx->Host, 1);
+
+    // put a simulated link between us and the server if we were asked to
+    if (ctx->Pool == NULL && ctx->SimulateLink)
+        ctx->Link = NetLinkSimAttach(ctx->Host, &ctx->LinkConditions);
+
+    // set the address and port we will connect to
+    enet_address_set_host(&ctx->Address, hostName);
+    ctx->Address.port = port;
+
+    // start the connection process. Will be finished as part of our update
+    ctx->Server = enet_host_connect(ctx->Host, &ctx->Address, 1, 0);
+    if (ctx->Server == NULL)
+        return false;
+
+    // remember who owns this connection so a shared host can route events back to us
+    enet_peer_set_data(ctx->Server, ctx);
+    return true;
+}
+
+/// <summary>
+/// Read a player position from the network message
+/// player positions are sent as two signed shorts and converted into floats for display
+/// since this sample does everything in pixels, this is fine, but a more robust game would want to send floats
+/// </summary>
+/// <param name="message"></param>
+/// <param name="offset"></param>
+/// <returns>A vector with the position in the data</returns>
+static NetVector2 ReadPosition(const NetMessage* message, size_t* offset)
+{
+    NetVector2 pos = { 0 };
+    pos.x = ReadShort(message, offset);
+    pos.y = ReadShort(message, offset);
+
+    return pos;
+}
+
+// read the position and direction of a remote player and remember when we got them
+static void SetPlayerMovement(NetClient* ctx, int playerId, const NetMessage* message, size_t* offset)
+{
+    NetVector2 position = ReadPosition(message, offset);
+    NetVector2 direction = ReadPosition(message, offset);
+
+    ctx->Players->X[playerId] = position.x;
+    ctx->Players->Y[playerId] = position.y;
+    ctx->Players->DX[playerId] = direction.x;
+    ctx->Players->DY[playerId] = direction.y;
+    ctx->Players->UpdateTime[playerId] = ctx->LastNow;
+}
+
+// read the entity id the server is talking about, -1 if it isn't one that can exist
+static int ReadEntityId(const NetMessage* message, size_t* offset)
+{
+    uint32_t id = ReadInt(message, offset);
+    return id < MAX_ENTITIES ? (int)id : -1;
+}
+
+// the store starts with room for the players, and grows when the server tells us about an NPC past the end of it
+static bool MakeRoom(NetClient* ctx, int id)
+{
+    if (id < ctx->Players->Capacity)
+        return true;
+
+    // double it so a crowd of NPCs arriving one at a time only moves the store a few times
+    int capacity = ctx->Players->Capacity * 2;
+    if (capacity <= id)
+        capacity = id + 1;
+    if (capacity > MAX_ENTITIES)
+        capacity = MAX_ENTITIES;
+
+    NetEntityStore* players = NetEntityStoreResize(ctx->Players, capacity);
+    if (players == NULL)
+        return false;
+
+    ctx->Players = players;
+    return true;
+}
+
+// functions to handle the commands that the server will send to the client
+// these take the data from enet and read out various bits of data from it to do actions based on the command that was sent
+
+// A new remote player (or NPC) was added to our local simulation
+static void HandleAddPlayer(NetClient* ctx, const NetMessage* message, size_t* offset)
+{
+    // find out who the server is talking about
+    int remotePlayer = ReadEntityId(message, offset);
+    if (remotePlayer < 0 || remotePlayer == ctx->LocalPlayerId || !MakeRoom(ctx, remotePlayer))
+        return;
+
+    // set them as active and update the location
+    ctx->Players->Flags[remotePlayer] = EntityActive | EntityExtrapolated;
+    SetPlayerMovement(ctx, remotePlayer, message, offset);
+
+    // In a more robust game, this message would have more info about the new player, such as what sprite or model to use, player name, or other data a client would need
+    // this is where static data about the player would be sent, and any initial state needed to setup the local simulation
+}
+
+// A remote player has left the game and needs to be removed from the local simulation
+static void HandleRemovePlayer(NetClient* ctx, const NetMessage* message, size_t* offset)
+{
+    // find out who the server is talking about
+    int remotePlayer = ReadEntityId(message, offset);
+    if (remotePlayer < 0 || remotePlayer >= ctx->Players->Capacity || remotePlayer == ctx->LocalPlayerId)
+        return;
+
+    // remove the player from the simulation. No other data is needed except the player id
+    ctx->Players->Flags[remotePlayer] = 0;
+}
+
+// The server has a new position for a player in our local simulation
+static void HandleUpdatePlayer(NetClient* ctx, const NetMessage* message, size_t* offset)
+{
+    // find out who the server is talking about
+    int remotePlayer = ReadEntityId(message, offset);
+    if (remotePlayer < 0 || remotePlayer >= ctx->Players->Capacity || !(ctx->Players->Flags[remotePlayer] & EntityActive))
+        return;
+
+    // the server didn't believe where we said we were, so we go where it says
+    if (remotePlayer == ctx->LocalPlayerId)
+    {
+        NetVector2 position = ReadPosition(message, offset);
+        ctx->Players->X[remotePlayer] = position.x;
+        ctx->Players->Y[remotePlayer] = position.y;
+        return;
+    }
+
+    // update the last known position and movement
+    SetPlayerMovement(ctx, remotePlayer, message, offset);
+
+    // in a more robust game this message would have a tick ID for what time this information was valid, and extra info about
+    // what the input state was so the local simulation could do prediction and smooth out the motion
+}
+
+// Someone tagged someone, the server has already judged it
+static void HandlePlayerTagged(NetClient* ctx, const NetMessage* message, size_t* offset)
+{
+    // the tagger isn't shown, we only mark who was tagged
+    ReadByte(message, offset);
+    int target = ReadByte(message, offset);
+    if (target >= MAX_PLAYERS)
+        return;
+
+    ctx->TaggedPlayer = target;
+    ctx->TaggedTime = ctx->LastNow;
+}
+
+// Check the clock to see if it is time for us to send the updated position for the local player
+// we do this so that we don't spam the server with updates 60 times a second and waste bandwidth
+// in a real game we'd send our normalized movement vector or input keys along with what the current tick index was
+// this way the server can know how long it's been since the last update and can do interpolation to know were we are between updates.
+static void SendInput(NetClient* ctx, double now)
+{
+    if (ctx->LocalPlayerId < 0 || now - ctx->LastInputSend <= InputUpdateInterval)
+        return;
+
+    // Pack up a buffer with the data we want to send
+    uint8_t buffer[9] = { 0 }; // 9 bytes for a 1 byte command number and two bytes for each X and Y value
+    buffer[0] = (uint8_t)UpdateInput;   // this tells the server what kind of data to expect in this packet
+    *(int16_t*)(buffer + 1) = (int16_t)ctx->Players->X[ctx->LocalPlayerId];
+    *(int16_t*)(buffer + 3) = (int16_t)ctx->Players->Y[ctx->LocalPlayerId];
+    *(int16_t*)(buffer + 5) = (int16_t)ctx->Players->DX[ctx->LocalPlayerId];
+    *(int16_t*)(buffer + 7) = (int16_t)ctx->Players->DY[ctx->LocalPlayerId];
+
+    NetCaptureWrite(ctx->Capture, 0, CaptureSent, buffer, 9);
+
+    // copy this data into a packet provided by enet (TODO : add pack functions that write directly to the packet to avoid the copy)
+    ENetPacket* packet = enet_packet_create(buffer,9,ENET_PACKET_FLAG_RELIABLE);
+
+    // send the packet to the server
+    enet_peer_send(ctx->Server, 0, packet);
+
+    // NOTE enet_host_service will handle releasing send packets when the network system has finally sent them,
+    // you don't have to destroy them
+
+    // mark that now was the last time we sent an update
+    ctx->LastInputSend = now;
+}
+
+// handle one message from the server
+bool NetClientHandleMessage(NetClient* ctx, const NetMessage* message)
+{
+    // we know that all valid packets have a size >= 1, so if we get this, something is bad and we ignore it.
+    if (message->Length < 1)
+        return false;
+
+    // keep an offset of what data we have read so far
+    size_t offset = 0;
+
+    // read off the command that the server wants us to do
+    NetworkCommands command = (NetworkCommands)ReadByte(message, &offset);
+
+    // if the server has not accepted us yet, we are limited in what packets we can receive
+    if (ctx->LocalPlayerId == -1)
+    {
+        if (command != AcceptPlayer)    // this is the only thing we can do in this state, so ignore anything else
+            return false;
+
+        // See who the server says we are
+        ctx->LocalPlayerId = ReadByte(message, &offset);
+
+        // Make sure that it makes sense
+        if (ctx->LocalPlayerId < 0 || ctx->LocalPlayerId >= MAX_PLAYERS)
+        {
+            ctx->LocalPlayerId = -1;
+            return false;
+        }
+
+        // start counting server ticks from the one the server was on when it accepted us
+        // the accept took half a round trip to get here, so this is the tick of the newest state we can see, which is what we want
+        ctx->AcceptTick = ReadInt(message, &offset);
+        ctx->AcceptTime = ctx->LastNow;
+
+        // Force the next frame to do an update by pretending it's been a very long time since our last update
+        ctx->LastInputSend = -InputUpdateInterval;
+
+        // We are active, and we move our own player
+        ctx->Players->Flags[ctx->LocalPlayerId] = EntityActive | EntityIntegrated;
+
+        // Set our player at some location on the field.
+        // optimally we would do a much more robust connection negotiation where we tell the server what our name is, what we look like
+        // and then the server tells us where we are
+        // But for this simple test, everyone starts at the same place on the field
+        ctx->Players->X[ctx->LocalPlayerId] = 100;
+        ctx->Players->Y[ctx->LocalPlayerId] = 100;
+        return true;
+    }
+
+    // we have been accepted, so process play messages from the server
+    // see what the server wants us to do
+    switch (command)
+    {
+    case AddPlayer:
+        HandleAddPlayer(ctx, message, &offset);
+        return true;
+
+    case RemovePlayer:
+        HandleRemovePlayer(ctx, message, &offset);
+        return true;
+
+    case UpdatePlayer:
+        HandleUpdatePlayer(ctx, message, &offset);
+        return true;
+
+    case PlayerTagged:
+        HandlePlayerTagged(ctx, message, &offset);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+// process one event that enet gave us for this client
+static void HandleEvent(NetClient* ctx, ENetEvent* event)
+{
+    // see what kind of event it is
+    switch (event->type)
+    {
+    // the server sent us some data, we should process it
+    case ENET_EVENT_TYPE_RECEIVE:
+    {
+        NetMessage message = { event->packet->data, event->packet->dataLength };
+        NetCaptureWrite(ctx->Capture, 0, CaptureReceived, message.Data, message.Length);
+
+        NetClientHandleMessage(ctx, &message);
+
+        // tell enet that it can recycle the packet data
+        enet_packet_destroy(event->packet);
+        break;
+    }
+
+    // the server accepted the connection, the game play starts when it sends us our player id
+    case ENET_EVENT_TYPE_CONNECT:
+        NetCaptureWrite(ctx->Capture, 0, CaptureConnected, NULL, 0);
+        break;
+
+    // we were disconnected, we have a sad
+    case ENET_EVENT_TYPE_DISCONNECT:
+    case ENET_EVENT_TYPE_DISCONNECT_TIMEOUT:
+        NetCaptureWrite(ctx->Capture, 0, CaptureDisconnected, NULL, 0);
+        ctx->Server = NULL;
+        ctx->LocalPlayerId = -1;
+        break;
+
+    case ENET_EVENT_TYPE_NONE:
+        break;
+    }
+}
+
+// update all the remote players with an interpolated position based on the last known good pos and how long it has been since an update
+static void ExtrapolatePlayers(NetClient* ctx)
+{
+    NetEntityExtrapolate(ctx->Players, ctx->LastNow);
+}
+
+// process one frame of updates
+void NetClientUpdate(NetClient* ctx, double now, float deltaT)
+{
+    // remote players are extrapolated from now, the frame time is only used to move the local player (NetClientUpdateLocalPlayer)
+    (void)deltaT;
+
+    ctx->LastNow = now;
+    // if we are not connected to anything yet, we can't do anything, so bail out early
+    if (ctx->Server == NULL)
+        return;
+
+    // Check if we have been accepted, and if so send our position when the network tick comes around
+    SendInput(ctx, now);
+
+    // pooled clients get their events from NetClientPoolUpdate
+    if (ctx->Pool == NULL)
+    {
+        // read one event from enet and process it
+        ENetEvent Event = { 0 };
+
+        // Check to see if we even have any events to do. Since this is a a client, we don't set a timeout so that the client can keep going if there are no events
+        if (enet_host_service(ctx->Host, &Event, 0) > 0)
+            HandleEvent(ctx, &Event);
+
+        // send anything the simulated link has held until now
+        NetLinkSimUpdate(ctx->Link, 0);
+    }
+
+    ExtrapolatePlayers(ctx);
+}
+
+// close the connection to the server
+void NetClientDisconnect(NetClient* ctx)
+{
+    // close our connection to the server
+    if (ctx->Server != NULL)
+    {
+        enet_peer_set_data(ctx->Server, NULL);
+        enet_peer_disconnect(ctx->Server, 0);
+    }
+
+    // close our client, a pooled host belongs to the pool
+    if (ctx->Host != NULL && ctx->Pool == NULL)
+    {
+        // make sure the disconnect goes out before the host goes away, the simulator sends what it still holds when it is removed
+        enet_host_flush(ctx->Host);
+        NetLinkSimDetach(ctx->Link);
+        ctx->Link = NULL;
+        enet_host_destroy(ctx->Host);
+        ctx->Host = NULL;
+    }
+
+    ctx->Server = NULL;
+    ctx->LocalPlayerId = -1;
+}
+
+// true if we are connected and have been accepted
+bool NetClientConnected(NetClient* ctx)
+{
+    return ctx->Server != NULL && ctx->LocalPlayerId >= 0;
+}
+
+int NetClientGetLocalPlayerId(NetClient* ctx)
+{
+    return ctx->LocalPlayerId;
+}
+
+// add the input to our local position and make sure we are still inside the field
+void NetClientUpdateLocalPlayer(NetClient* ctx, NetVector2* movementDelta, float deltaT)
+{
+    // if we are not accepted, we can't update
+    if (ctx->LocalPlayerId < 0)
+        return;
+
+    // our direction is the movement we want, add it to our location
+    ctx->Players->DX[ctx->LocalPlayerId] = movementDelta->x;
+    ctx->Players->DY[ctx->LocalPlayerId] = movementDelta->y;
+    NetEntityIntegrate(ctx->Players, deltaT);
+
+    // make sure we are in bounds.
+    // In a real game both the client and the server would do this to help prevent cheaters
+    NetEntityClamp(ctx->Players, 0, 0, FieldSizeWidth - PlayerSize, FieldSizeHeight - PlayerSize);
+}
+
+// get the info for a particular player
+bool NetClientGetPlayerPos(NetClient* ctx, int id, NetVector2* pos)
+{
+    // make sure the player is valid and active
+    if (id < 0 || id >= ctx->Players->Capacity || !(ctx->Players->Flags[id] & EntityActive))
+        return false;
+
+    // copy the location (real or extrapolated)
+    if (id == ctx->LocalPlayerId)
+    {
+        pos->x = ctx->Players->X[id];
+        pos->y = ctx->Players->Y[id];
+    }
+    else
+    {
+        pos->x = ctx->Players->ExtrapolatedX[id];
+        pos->y = ctx->Players->ExtrapolatedY[id];
+    }
+    return true;
+}
+
+// how many entity ids there is room for
+int NetClientGetEntityCount(NetClient* ctx)
+{
+    return ctx->Players->Capacity;
+}
+
+// the server tick that goes with what we are showing now
+uint32_t NetClientGetServerTick(NetClient* ctx)
+{
+    return ctx->AcceptTick + (uint32_t)((ctx->LastNow - ctx->AcceptTime) * ServerTickRate);
+}
+
+// tag the closest player in range
+bool NetClientTag(NetClient* ctx)
+{
+    if (!NetClientConnected(ctx))
+        return false;
+
+    NetEntityStore* players = ctx->Players;
+    float x = players->X[ctx->LocalPlayerId];
+    float y = players->Y[ctx->LocalPlayerId];
+
+    // find the closest remote player, by where we are showing them
+    int target = -1;
+    float closest = TagRange;
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (!(players->Flags[i] & EntityExtrapolated))
+            continue;
+
+        float dx = players->ExtrapolatedX[i] - x;
+        float dy = players->ExtrapolatedY[i] - y;
+        dx = dx < 0 ? -dx : dx;
+        dy = dy < 0 ? -dy : dy;
+
+        float distance = dx > dy ? dx : dy;
+        if (distance <= closest)
+        {
+            closest = distance;
+            target = i;
+        }
+    }
+
+    if (target < 0)
+        return false;
+
+    // tell the server who we tagged and the tick we were seeing, so it can check against where they were then
+    uint8_t buffer[6] = { 0 };
+    buffer[0] = (uint8_t)TagPlayer;
+    buffer[1] = (uint8_t)target;
+    uint32_t tick = NetClientGetServerTick(ctx);
+    memcpy(buffer + 2, &tick, 4);
+
+    NetCaptureWrite(ctx->Capture, 0, CaptureSent, buffer, 6);
+    enet_peer_send(ctx->Server, 0, enet_packet_create(buffer, 6, ENET_PACKET_FLAG_RELIABLE));
+    return true;
+}
+
+// the player tagged in the last second
+int NetClientGetTaggedPlayer(NetClient* ctx)
+{
+    if (ctx->TaggedPlayer < 0 || ctx->LastNow - ctx->TaggedTime > 1.0)
+        return -1;
+
+    return ctx->TaggedPlayer;
+}
+
+// record all traffic for this client
+void NetClientSetCapture(NetClient* ctx, NetCapture* capture)
+{
+    ctx->Capture = capture;
+}
+
+// simulate link conditions on our own host
+void NetClientSetLink(NetClient* ctx, const NetLinkConditions* conditions)
+{
+    ctx->SimulateLink = conditions != NULL;
+    if (conditions != NULL)
+        ctx->LinkConditions = *conditions;
+}
+
+// set the time the client uses for incoming messages, without running a network update
+void NetClientSetTime(NetClient* ctx, double now)
+{
+    ctx->LastNow = now;
+    ExtrapolatePlayers(ctx);
+}
+
+// FNV-1a over everything that makes up the local simulation
+uint64_t NetClientStateHash(NetClient* ctx)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < ctx->Players->Capacity; i++)
+    {
+        const NetEntityStore* players = ctx->Players;
+        float values[] = { (float)((players->Flags[i] & EntityActive) != 0), (float)(i == ctx->LocalPlayerId), players->X[i], players->Y[i], players->DX[i], players->DY[i] };
+
+        const uint8_t* bytes = (const uint8_t*)values;
+        for (size_t b = 0; b < sizeof(values); b++)
+        {
+            hash ^= bytes[b];
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+// create a pool of clients that share one host
+NetClientPool* NetClientPoolCreate(int maxClients)
+{
+    if (maxClients <= 0 || enet_initialize() != 0)
+        return NULL;
+
+    NetClientPool* pool = (NetClientPool*)enet_malloc(sizeof(NetClientPool));
+    if (pool == NULL)
+    {
+        enet_deinitialize();
+        return NULL;
+    }
+
+    pool->MaxClients = maxClients;
+    pool->Clients = (NetClient**)enet_malloc(sizeof(NetClient*) * maxClients);
+    pool->FreeSlots = (int*)enet_malloc(sizeof(int) * maxClients);
+    pool->Host = enet_host_create(NULL, maxClients, 1, 0, 0);
+
+    // the server checksums and compresses every datagram, so we have to as well
+    if (pool->Host != NULL)
+        pool->Host->checksum = enet_crc32;
+
+    if (pool->Clients == NULL || pool->FreeSlots == NULL || pool->Host == NULL || !NetCompressAttach(pool->Host, NetCompressGameDictionary, NetCompressGameDictionarySize))
+    {
+        if (pool->Host != NULL)
+            enet_host_destroy(pool->Host);
+        if (pool->Clients != NULL)
+            enet_free(pool->Clients);
+        if (pool->FreeSlots != NULL)
+            enet_free(pool->FreeSlots);
+        enet_free(pool);
+        enet_deinitialize();
+        return NULL;
+    }
+
+    enet_host_zero_copy(pool->Host, 1);
+
+    // every slot starts free, lowest on top so clients fill the pool in order
+    memset(pool->Clients, 0, sizeof(NetClient*) * maxClients);
+    for (int i = 0; i < maxClients; i++)
+        pool->FreeSlots[i] = maxClients - 1 - i;
+    pool->FreeCount = maxClients;
+    return pool;
+}
+
+// destroy a pool and its host
+void NetClientPoolDestroy(NetClientPool* pool)
+{
+    if (pool == NULL)
+        return;
+
+    enet_host_flush(pool->Host);
+    enet_host_destroy(pool->Host);
+    enet_free(pool->Clients);
+    enet_free(pool->FreeSlots);
+    enet_free(pool);
+    enet_deinitialize();
+}
+
+// service the shared host and update every client in the pool
+void NetClientPoolUpdate(NetClientPool* pool, double now, float deltaT)
+{
+    for (int i = 0; i < pool->MaxClients; i++)
+    {
+        if (pool->Clients[i] != NULL)
+            pool->Clients[i]->LastNow = now;
+    }
+
+    // drain every event on the shared host, each peer knows which client it belongs to
+    ENetEvent Event = { 0 };
+    while (enet_host_service(pool->Host, &Event, 0) > 0)
+    {
+        NetClient* ctx = (NetClient*)enet_peer_get_data(Event.peer);
+        if (ctx != NULL)
+            HandleEvent(ctx, &Event);
+        else if (Event.type == ENET_EVENT_TYPE_RECEIVE)
+            enet_packet_destroy(Event.packet);
+    }
+
+    for (int i = 0; i < pool->MaxClients; i++)
+    {
+        if (pool->Clients[i] != NULL)
+            NetClientUpdate(pool->Clients[i], now, deltaT);
+    }
+}
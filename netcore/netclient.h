@@ -0,0 +1,128 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// The network client interface.
+// This is the network game play for one client, with no raylib or windows.h in it, so bots and tools can use it headless.
+// It does not include enet, so it is safe to include next to raylib
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "netmath.h"
+#include "protocol.h"
+#include "capture.h"
+#include "linksim.h"
+
+// A single network client instance.
+// Every piece of state that used to live in globals (the enet host, the server peer, the local player id and the local simulation)
+// lives in one of these, so a process can run as many protocol accurate clients as it wants (bots, load tests, soak tests).
+// The graphical client uses a default instance through the wrappers in networking.h
+typedef struct NetClient NetClient;
+
+// A group of clients that share one enet host (one socket) and are serviced together.
+// This keeps a bot swarm from needing one socket and one service call per client.
+typedef struct NetClientPool NetClientPool;
+
+// create a client instance, it is not connected to anything yet
+NetClient* NetClientCreate();
+
+// create a client instance that uses the shared host of a pool
+// returns NULL if the pool is full
+NetClient* NetClientCreateInPool(NetClientPool* pool);
+
+// disconnect and free a client instance
+void NetClientDestroy(NetClient* ctx);
+
+// Start connecting a client to a server. This will be finished as part of NetClientUpdate
+bool NetClientConnect(NetClient* ctx, const char* hostName, uint16_t port);
+
+// Process one frame of updates for a client
+void NetClientUpdate(NetClient* ctx, double now, float deltaT);
+
+// Disconnect a client from the server, the instance can connect again later
+void NetClientDisconnect(NetClient* ctx);
+
+// True if the client is connected to the server and has a valid player id.
+bool NetClientConnected(NetClient* ctx);
+
+// Tell the client how far we wanted to move this frame
+void NetClientUpdateLocalPlayer(NetClient* ctx, NetVector2* movementDelta, float deltaT);
+
+// get the id that the server assigned to the client
+int NetClientGetLocalPlayerId(NetClient* ctx);
+
+// get the position info for a player (or NPC) from the client's local simulation
+// returns false if the player id is not valid
+bool NetClientGetPlayerPos(NetClient* ctx, int id, NetVector2* pos);
+
+// Get how many entity ids the client has room for, every player and NPC it knows about has an id below this
+// it starts at MAX_PLAYERS and grows as the server tells us about NPCs
+int NetClientGetEntityCount(NetClient* ctx);
+
+// Get the server tick that goes with what the client is showing now
+// the client learns the server's tick when it is accepted and counts on from there at ServerTickRate
+uint32_t NetClientGetServerTick(NetClient* ctx);
+
+// Tag the closest other player within TagRange of the local player
+// the server judges the tag against where that player was on the tick we were seeing, and tells everyone if it was good
+// returns false if there was nobody close enough to tag
+bool NetClientTag(NetClient* ctx);
+
+// Get the player who was tagged in the last second, or -1
+int NetClientGetTaggedPlayer(NetClient* ctx);
+
+// Record everything the client sends and receives into a capture, pass NULL to stop recording
+// the capture is not owned by the client, the caller closes it
+void NetClientSetCapture(NetClient* ctx, NetCapture* capture);
+
+// Run the client's own host through a simulated link on the next connect, pass NULL to connect without one
+// pooled clients share a host and are not simulated
+void NetClientSetLink(NetClient* ctx, const NetLinkConditions* conditions);
+
+// Handle one message from the server as if it was just received
+// this is what the network update uses, and what tools use to replay captures without a socket
+// returns false if the message was not valid for the state the client is in
+bool NetClientHandleMessage(NetClient* ctx, const NetMessage* message);
+
+// Set the time used for incoming messages and update the extrapolated player positions, without doing any networking
+void NetClientSetTime(NetClient* ctx, double now);
+
+// A hash of the client's local simulation, two clients that were given the same messages will have the same hash
+uint64_t NetClientStateHash(NetClient* ctx);
+
+// create a pool that can hold up to maxClients clients on one shared host
+NetClientPool* NetClientPoolCreate(int maxClients);
+
+// destroy a pool, all clients in the pool must be destroyed first
+void NetClientPoolDestroy(NetClientPool* pool);
+
+// Service the shared host of a pool, handing every pending event to the client it belongs to,
+// then run the per frame update for every client in the pool
+void NetClientPoolUpdate(NetClientPool* pool, double now, float deltaT);
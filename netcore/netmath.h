@@ -0,0 +1,54 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// Small 2D vector math for the network core.
+// raymath.h can't be used here since the network core is built without raylib (the server and tools don't draw anything)
+// so this has just the few operations the game play code needs.
+#pragma once
+
+// A 2D vector, same layout as the raylib Vector2 so the client can convert between them for free
+typedef struct
+{
+    float x;
+    float y;
+}NetVector2;
+
+// Add two vectors
+static inline NetVector2 NetVector2Add(NetVector2 v1, NetVector2 v2)
+{
+    NetVector2 result = { v1.x + v2.x, v1.y + v2.y };
+    return result;
+}
+
+// Scale a vector by a value
+static inline NetVector2 NetVector2Scale(NetVector2 v, float scale)
+{
+    NetVector2 result = { v.x * scale, v.y * scale };
+    return result;
+}
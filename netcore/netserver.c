@@ -0,0 +1,819 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// implementation of the server game play
+
+#include "netserver.h"
+#include "entities.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// how long between simulation ticks
+static double TickInterval = 1.0 / ServerTickRate;
+
+// what an update costs a connection's budget, the 13 byte message and the 6 bytes enet puts in front of it
+#define UpdateCost 19
+
+// how much more a connection wants news about an entity right next to its player than one across the field
+static float NearWeight = 3.0f;
+
+// how much a standing entity's news is worth compared to a moving one, a stale position of something standing still is less wrong
+static float StandingWeight = 0.5f;
+
+// how many ticks of player positions the server keeps to rewind to, a bit over a second
+// a client that says it saw something longer ago than this gets judged on the oldest tick we have
+#define HistoryTicks 32
+
+// how many seconds of full speed movement a player can save up, so a late input followed by an early one isn't rejected
+static float MoveBurst = 0.5f;
+
+// how much faster than PlayerMoveSpeed the saved movement refills, the server and the client never agree exactly on when a player turned
+static float MoveSlack = 1.25f;
+
+struct NetServer
+{
+    // how we send data to connections
+    NetServerSendCallback Send;
+    void* SendUser;
+
+    // All possible players, one entity per player id, followed by the NPCs
+    // this is the server state of the game that represents the current game state
+    // this is what server code would check to see where all the players are and what they are doing
+    // EntityActive is set for a slot in use, and EntityValidPosition once they have sent us a position
+    NetEntityStore* Players;
+
+    // how many NPCs there are, they have the entity ids from MAX_PLAYERS up and are always on the field
+    int NPCCount;
+
+    // where each NPC is heading, indexed by entity id like the store so only the NPC part is used
+    float* TargetX;
+    float* TargetY;
+
+    // the state of the random numbers that pick where NPCs go
+    uint32_t Random;
+
+    // the network connection each player uses
+    uint16_t Connections[MAX_PLAYERS];
+
+    // the last position each player sent us, and whether there is one the next tick has not looked at yet
+    float ClaimX[MAX_PLAYERS];
+    float ClaimY[MAX_PLAYERS];
+    bool PendingInput[MAX_PLAYERS];
+
+    // where each player was at the end of the last tick, and how far they may still move, see MoveBurst
+    float PreviousX[MAX_PLAYERS];
+    float PreviousY[MAX_PLAYERS];
+    float MoveBudget[MAX_PLAYERS];
+
+    // when the last tick ran and when the next one is due, NextTick is 0 before the first update
+    double LastTick;
+    double NextTick;
+
+    // the number of the last tick that ran
+    uint32_t Tick;
+
+    // where every player was at the end of each of the last HistoryTicks ticks, a ring indexed by tick % HistoryTicks
+    // each tick is one flat row per field, copied straight out of the entity store
+    uint32_t HistoryTick[HistoryTicks];
+    uint32_t HistoryFlags[HistoryTicks][MAX_PLAYERS];
+    float HistoryX[HistoryTicks][MAX_PLAYERS];
+    float HistoryY[HistoryTicks][MAX_PLAYERS];
+
+    // how many claimed positions were not possible
+    uint64_t RejectedMoves;
+
+    // how many bytes of updates a connection can take per tick, NULL for no limit
+    NetServerBudgetCallback Budget;
+
+    // the update scheduler, each array has a row per player (the receiver) with a column per entity, see ScheduleUpdates
+    // the priority of sending each entity to each player, the version of each entity each player has seen, and what was picked this tick
+    float* Priority;
+    uint32_t* SentVersion;
+    uint8_t* Picked;
+
+    // bumped every time an entity has news to send
+    uint32_t* Version;
+
+    // scratch for picking the highest priorities, a min heap of entity ids
+    int* Heap;
+};
+
+// true if a player slot has a flag set
+static bool HasFlag(NetServer* server, int playerId, uint32_t flag)
+{
+    return (server->Players->Flags[playerId] & flag) != 0;
+}
+
+// finds the player slot that goes with the player connection
+static int GetPlayerId(NetServer* server, uint16_t connection)
+{
+    // find the slot that matches the connection
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (HasFlag(server, i, EntityActive) && server->Connections[i] == connection)
+            return i;
+    }
+    return -1;
+}
+
+// keep a direction within how fast a player can move
+static float CapSpeed(float speed)
+{
+    if (speed > PlayerMoveSpeed)
+        return PlayerMoveSpeed;
+
+    if (speed < -PlayerMoveSpeed)
+        return -PlayerMoveSpeed;
+
+    return speed;
+}
+
+// how far a move goes, the speed cap is per axis so this is the longest axis
+static float MoveDistance(float dx, float dy)
+{
+    dx = dx < 0 ? -dx : dx;
+    dy = dy < 0 ? -dy : dy;
+    return dx > dy ? dx : dy;
+}
+
+// true if a position is somewhere a player can be
+static bool OnField(float x, float y)
+{
+    return x >= 0 && y >= 0 && x <= FieldSizeWidth - PlayerSize && y <= FieldSizeHeight - PlayerSize;
+}
+
+// send a message to one connection
+static void SendTo(NetServer* server, uint16_t connection, const uint8_t* data, size_t length)
+{
+    server->Send(server->SendUser, &connection, 1, data, length);
+}
+
+// sends a message to every active player, except the one specified (usually the sender)
+// senders know what they sent so you can choose to not send them data they already know.
+// in a truly authoritive server you'd send back an acceptance message to all client input so they know it wasn't rejected.
+static void SendToAllBut(NetServer* server, const uint8_t* data, size_t length, int exceptPlayerId)
+{
+    uint16_t connections[MAX_PLAYERS];
+    size_t count = 0;
+
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (!HasFlag(server, i, EntityActive) || i == exceptPlayerId)
+            continue;
+
+        connections[count++] = server->Connections[i];
+    }
+
+    if (count > 0)
+        server->Send(server->SendUser, connections, count, data, length);
+}
+
+// pack up a player message with the command, entity ID and the last known position
+static void PackPlayer(NetServer* server, NetworkCommands command, int playerId, uint8_t buffer[13])
+{
+    uint32_t id = (uint32_t)playerId;
+    buffer[0] = (uint8_t)command;
+    memcpy(buffer + 1, &id, 4);
+    *(int16_t*)(buffer + 5) = (int16_t)server->Players->X[playerId];
+    *(int16_t*)(buffer + 7) = (int16_t)server->Players->Y[playerId];
+    *(int16_t*)(buffer + 9) = (int16_t)server->Players->DX[playerId];
+    *(int16_t*)(buffer + 11) = (int16_t)server->Players->DY[playerId];
+}
+
+// the next of the random numbers that move the NPCs, a xorshift so two servers given the same events move them the same way
+static uint32_t NextRandom(NetServer* server)
+{
+    uint32_t x = server->Random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    server->Random = x;
+    return x;
+}
+
+// a random place on the field on one axis, anywhere a player could be
+static float RandomPlace(NetServer* server, int fieldSize)
+{
+    return (float)(NextRandom(server) % (uint32_t)(fieldSize - PlayerSize + 1));
+}
+
+// round to the nearest whole number, without pulling in the math library for roundf
+static float RoundWhole(float value)
+{
+    return (float)(int)(value < 0 ? value - 0.5f : value + 0.5f);
+}
+
+// send an NPC off toward a new random place, which is news for everyone
+static void PickTarget(NetServer* server, int npc)
+{
+    NetEntityStore* players = server->Players;
+    server->TargetX[npc] = RandomPlace(server, FieldSizeWidth);
+    server->TargetY[npc] = RandomPlace(server, FieldSizeHeight);
+
+    // head straight for it with the longest axis at full speed, like the player speed cap
+    // the direction is kept to whole numbers because that is all an update carries, so the clients extrapolate exactly what we integrate
+    float dx = server->TargetX[npc] - players->X[npc];
+    float dy = server->TargetY[npc] - players->Y[npc];
+    float distance = MoveDistance(dx, dy);
+    if (distance < 1)
+    {
+        players->DX[npc] = players->DY[npc] = 0;
+    }
+    else
+    {
+        players->DX[npc] = RoundWhole(dx / distance * NPCMoveSpeed);
+        players->DY[npc] = RoundWhole(dy / distance * NPCMoveSpeed);
+    }
+
+    server->Version[npc]++;
+}
+
+// put the NPCs on the field, each at a random place and heading for another
+static void SpawnNPCs(NetServer* server)
+{
+    NetEntityStore* players = server->Players;
+    for (int i = MAX_PLAYERS; i < MAX_PLAYERS + server->NPCCount; i++)
+    {
+        players->Flags[i] = EntityActive | EntityIntegrated | EntityValidPosition;
+        players->X[i] = RandomPlace(server, FieldSizeWidth);
+        players->Y[i] = RandomPlace(server, FieldSizeHeight);
+        PickTarget(server, i);
+    }
+}
+
+// turn the NPCs that have reached (or gone past) where they were heading toward somewhere new
+// the pass only reads the arrays it needs, so a big crowd costs a few multiplies each
+static void SteerNPCs(NetServer* server)
+{
+    NetEntityStore* players = server->Players;
+    for (int i = MAX_PLAYERS; i < MAX_PLAYERS + server->NPCCount; i++)
+    {
+        float towardX = server->TargetX[i] - players->X[i];
+        float towardY = server->TargetY[i] - players->Y[i];
+        if (towardX * players->DX[i] + towardY * players->DY[i] <= 0)
+            PickTarget(server, i);
+    }
+}
+
+NetServer* NetServerCreate(NetServerSendCallback send, void* user, int npcCount)
+{
+    NetServer* server = (NetServer*)malloc(sizeof(NetServer));
+    if (server == NULL)
+        return NULL;
+
+    memset(server, 0, sizeof(NetServer));
+    server->Send = send;
+    server->SendUser = user;
+    server->NPCCount = npcCount < 0 ? 0 : npcCount > MAX_NPCS ? MAX_NPCS : npcCount;
+    server->Random = 0x9e3779b9;
+
+    server->Players = NetEntityStoreCreate(MAX_PLAYERS + server->NPCCount);
+    if (server->Players == NULL)
+    {
+        free(server);
+        return NULL;
+    }
+
+    size_t entities = (size_t)server->Players->Capacity;
+    server->Priority = (float*)calloc(MAX_PLAYERS * entities, sizeof(float));
+    server->SentVersion = (uint32_t*)calloc(MAX_PLAYERS * entities, sizeof(uint32_t));
+    server->Picked = (uint8_t*)calloc(MAX_PLAYERS * entities, sizeof(uint8_t));
+    server->Version = (uint32_t*)calloc(entities, sizeof(uint32_t));
+    server->Heap = (int*)calloc(entities, sizeof(int));
+    server->TargetX = (float*)calloc(entities, sizeof(float));
+    server->TargetY = (float*)calloc(entities, sizeof(float));
+
+    if (server->Priority == NULL || server->SentVersion == NULL || server->Picked == NULL || server->Version == NULL || server->Heap == NULL
+        || server->TargetX == NULL || server->TargetY == NULL)
+    {
+        NetServerDestroy(server);
+        return NULL;
+    }
+
+    SpawnNPCs(server);
+    return server;
+}
+
+void NetServerDestroy(NetServer* server)
+{
+    free(server->Priority);
+    free(server->SentVersion);
+    free(server->Picked);
+    free(server->Version);
+    free(server->Heap);
+    free(server->TargetX);
+    free(server->TargetY);
+    NetEntityStoreDestroy(server->Players);
+    free(server);
+}
+
+void NetServerSetBudget(NetServer* server, NetServerBudgetCallback budget)
+{
+    server->Budget = budget;
+}
+
+// a receiver has just been sent everything about an entity, so it has no news to wait for
+static void MarkSent(NetServer* server, int receiver, int entity)
+{
+    size_t index = (size_t)receiver * server->Players->Capacity + entity;
+    server->SentVersion[index] = server->Version[entity];
+    server->Priority[index] = 0;
+}
+
+// a new client is trying to connect
+int NetServerConnect(NetServer* server, uint16_t connection)
+{
+    // find an empty slot
+    int playerId = 0;
+    for (; playerId < MAX_PLAYERS; playerId++)
+    {
+        if (!HasFlag(server, playerId, EntityActive))
+            break;
+    }
+
+    // we are full
+    if (playerId == MAX_PLAYERS)
+        return -1;
+
+    // player is good, don't give away the slot
+    // but don't send out an update to everyone until they give us a good position
+    NetEntityClear(server->Players, playerId);
+    server->Players->Flags[playerId] = EntityActive;
+    server->Connections[playerId] = connection;
+    server->PendingInput[playerId] = false;
+
+    // pack up a message to send back to the client to tell them they have been accepted as a player
+    uint8_t buffer[6] = { 0 };
+    buffer[0] = (uint8_t)AcceptPlayer;  // command for the client
+    buffer[1] = (uint8_t)playerId;      // the player ID so they know who they are
+    memcpy(buffer + 2, &server->Tick, 4);   // the tick we are on, so they can count ticks with us
+
+    // send the data to the user
+    SendTo(server, connection, buffer, 6);
+
+    // We have to tell the new client about all the other players and NPCs that are already on the server.
+    // The new player hasn't been sent anything, so every entity with a position is news for them and the scheduler
+    // sends each one as an add message, nearest first and as fast as their budget allows (see ScheduleUpdates)
+    size_t entities = (size_t)server->Players->Capacity;
+    memset(server->SentVersion + (size_t)playerId * entities, 0, entities * sizeof(uint32_t));
+    memset(server->Priority + (size_t)playerId * entities, 0, entities * sizeof(float));
+
+    return playerId;
+}
+
+// a player says they tagged someone
+static void HandleTag(NetServer* server, int playerId, const NetMessage* message, size_t* offset)
+{
+    int target = ReadByte(message, offset);
+    uint32_t tick = ReadInt(message, offset);
+
+    if (target >= MAX_PLAYERS || target == playerId || !HasFlag(server, playerId, EntityValidPosition))
+        return;
+
+    // the tagger is where we have them now, which is where they were when they sent this
+    // the target is where the tagger saw them, rewound to the tick the tagger was looking at
+    NetVector2 seen;
+    if (!NetServerRewind(server, target, tick, &seen))
+        return;
+
+    float dx = seen.x - server->Players->X[playerId];
+    float dy = seen.y - server->Players->Y[playerId];
+    if (dx < -TagRange || dx > TagRange || dy < -TagRange || dy > TagRange)
+        return;
+
+    // a good tag, tell everyone
+    uint8_t buffer[3] = { 0 };
+    buffer[0] = (uint8_t)PlayerTagged;
+    buffer[1] = (uint8_t)playerId;
+    buffer[2] = (uint8_t)target;
+    SendToAllBut(server, buffer, 3, -1);
+}
+
+// someone sent us data
+bool NetServerHandleMessage(NetServer* server, uint16_t connection, const NetMessage* message)
+{
+    // find the player who sent the data
+    // we don't need them to send us what ID they are, we know who they are by the connection
+    // we want to trust the client as little as possible so that people can't cheat/hack
+    // if we blindly accepted a player ID, a client could send you updates for someone else :(
+    int playerId = GetPlayerId(server, connection);
+    if (playerId == -1)
+        return false;
+
+    // keep track of how far into the message we are
+    size_t offset = 0;
+
+    // read off the command the client wants us to process
+    NetworkCommands command = (NetworkCommands)ReadByte(message, &offset);
+
+    // a tag is judged against where the target was when the tagger saw them, not where they are now
+    if (command == TagPlayer)
+    {
+        HandleTag(server, playerId, message, &offset);
+        return true;
+    }
+
+    // the only other message we accept is an input update, so make sure this is what it is
+    if (command == UpdateInput)
+    {
+        NetEntityStore* players = server->Players;
+
+        // the position is only where the client thinks it is, the next tick decides if that was possible
+        server->ClaimX[playerId] = ReadShort(message, &offset);
+        server->ClaimY[playerId] = ReadShort(message, &offset);
+        server->PendingInput[playerId] = true;
+
+        // the direction is what we move them by, as fast as a player can go and no faster
+        players->DX[playerId] = CapSpeed(ReadShort(message, &offset));
+        players->DY[playerId] = CapSpeed(ReadShort(message, &offset));
+
+        // a new player starts where they say they are, as long as it is on the field, and the server moves them from then on
+        if (!HasFlag(server, playerId, EntityIntegrated))
+        {
+            float x = server->ClaimX[playerId];
+            float y = server->ClaimY[playerId];
+            if (!OnField(x, y))
+                x = y = 0;
+
+            players->X[playerId] = server->PreviousX[playerId] = x;
+            players->Y[playerId] = server->PreviousY[playerId] = y;
+            server->MoveBudget[playerId] = PlayerMoveSpeed * MoveBurst;
+            players->Flags[playerId] |= EntityIntegrated;
+        }
+    }
+
+    return true;
+}
+
+// a player was disconnected
+void NetServerDisconnect(NetServer* server, uint16_t connection)
+{
+    // find them if they are a real player
+    int playerId = GetPlayerId(server, connection);
+    if (playerId == -1)
+        return;
+
+    // mark them as inactive
+    server->Players->Flags[playerId] = 0;
+    server->PendingInput[playerId] = false;
+
+    // Tell everyone that someone left
+    uint8_t buffer[5] = { 0 };
+    uint32_t id = (uint32_t)playerId;
+    buffer[0] = (uint8_t)RemovePlayer;
+    memcpy(buffer + 1, &id, 4);
+
+    SendToAllBut(server, buffer, 5, -1);
+}
+
+// remember where everyone is at the end of a tick
+static void RecordHistory(NetServer* server)
+{
+    int slot = server->Tick % HistoryTicks;
+    server->HistoryTick[slot] = server->Tick;
+    memcpy(server->HistoryFlags[slot], server->Players->Flags, sizeof(server->HistoryFlags[slot]));
+    memcpy(server->HistoryX[slot], server->Players->X, sizeof(server->HistoryX[slot]));
+    memcpy(server->HistoryY[slot], server->Players->Y, sizeof(server->HistoryY[slot]));
+}
+
+// swap two entries of the scheduling heap
+static void HeapSwap(int* heap, int a, int b)
+{
+    int entity = heap[a];
+    heap[a] = heap[b];
+    heap[b] = entity;
+}
+
+// move the entry at index down the min heap until the priorities under it are higher
+static void HeapSiftDown(int* heap, int count, int index, const float* priority)
+{
+    for (;;)
+    {
+        int child = index * 2 + 1;
+        if (child >= count)
+            return;
+
+        if (child + 1 < count && priority[heap[child + 1]] < priority[heap[child]])
+            child++;
+
+        if (priority[heap[index]] <= priority[heap[child]])
+            return;
+
+        HeapSwap(heap, index, child);
+        index = child;
+    }
+}
+
+// pick which entities each player gets an update about this tick
+// every entity with news a player hasn't had gains priority for that player each tick, faster when it is close and moving,
+// so the longer it waits the more it is worth. Each player then gets the highest priorities that fit in its budget,
+// and what doesn't fit waits for a later tick with a higher priority, so a player short of bandwidth gets fewer updates instead of a backlog.
+// An entity a player has never been sent is news too, it goes out as an add instead of an update
+static void ScheduleUpdates(NetServer* server)
+{
+    NetEntityStore* players = server->Players;
+    int entities = players->Capacity;
+
+    for (int receiver = 0; receiver < MAX_PLAYERS; receiver++)
+    {
+        if (!HasFlag(server, receiver, EntityActive))
+            continue;
+
+        float* priority = server->Priority + (size_t)receiver * entities;
+        uint32_t* sentVersion = server->SentVersion + (size_t)receiver * entities;
+        uint8_t* picked = server->Picked + (size_t)receiver * entities;
+        float x = players->X[receiver];
+        float y = players->Y[receiver];
+
+        // everything with news gets more important
+        int candidates = 0;
+        for (int i = 0; i < entities; i++)
+        {
+            if (i == receiver || !(players->Flags[i] & EntityValidPosition) || sentVersion[i] == server->Version[i])
+                continue;
+
+            float distance = MoveDistance(players->X[i] - x, players->Y[i] - y) / FieldSizeWidth;
+            float nearness = distance < 1 ? 1 - distance : 0;
+            float moving = (players->DX[i] != 0 || players->DY[i] != 0) ? 1 : StandingWeight;
+
+            priority[i] += moving * (1 + NearWeight * nearness);
+            server->Heap[candidates++] = i;
+        }
+
+        if (candidates == 0)
+            continue;
+
+        // how many updates fit, everything if there is no budget
+        int fit = candidates;
+        if (server->Budget != NULL)
+        {
+            size_t budget = server->Budget(server->SendUser, server->Connections[receiver]) / UpdateCost;
+            if (budget < (size_t)fit)
+                fit = (int)budget;
+        }
+
+        // keep the highest priorities in a min heap of the ones that fit, the lowest of them is on top to be replaced
+        if (fit < candidates)
+        {
+            int* heap = server->Heap;
+            for (int i = fit / 2 - 1; i >= 0; i--)
+                HeapSiftDown(heap, fit, i, priority);
+
+            for (int i = fit; i < candidates && fit > 0; i++)
+            {
+                if (priority[heap[i]] > priority[heap[0]])
+                {
+                    heap[0] = heap[i];
+                    HeapSiftDown(heap, fit, 0, priority);
+                }
+            }
+        }
+
+        for (int i = 0; i < fit; i++)
+            picked[server->Heap[i]] = 1;
+    }
+
+    // send each picked entity once, to every player that picked it, so they share the message
+    // the players that have never had it share an add instead
+    for (int i = 0; i < entities; i++)
+    {
+        uint16_t updated[MAX_PLAYERS];
+        uint16_t added[MAX_PLAYERS];
+        size_t updateCount = 0;
+        size_t addCount = 0;
+
+        for (int receiver = 0; receiver < MAX_PLAYERS; receiver++)
+        {
+            size_t index = (size_t)receiver * entities + i;
+            if (!server->Picked[index])
+                continue;
+
+            server->Picked[index] = 0;
+            if (server->SentVersion[index] == 0)
+                added[addCount++] = server->Connections[receiver];
+            else
+                updated[updateCount++] = server->Connections[receiver];
+
+            MarkSent(server, receiver, i);
+        }
+
+        uint8_t buffer[13] = { 0 };
+        if (addCount > 0)
+        {
+            // Optimally we'd also send other info like name, color, and other static player info.
+            PackPlayer(server, AddPlayer, i, buffer);
+            server->Send(server->SendUser, added, addCount, buffer, 13);
+        }
+
+        if (updateCount > 0)
+        {
+            PackPlayer(server, UpdatePlayer, i, buffer);
+            server->Send(server->SendUser, updated, updateCount, buffer, 13);
+        }
+    }
+}
+
+// one simulation tick, deltaT seconds after the last one
+static void Tick(NetServer* server, float deltaT)
+{
+    NetEntityStore* players = server->Players;
+
+    // the NPCs that got where they were going pick somewhere new
+    SteerNPCs(server);
+
+    // move everyone along the direction they last gave us (or the one they steered), and keep them on the field
+    NetEntityIntegrate(players, deltaT);
+    NetEntityClamp(players, 0, 0, FieldSizeWidth - PlayerSize, FieldSizeHeight - PlayerSize);
+
+    // check the positions the clients sent since the last tick against how far they could have gone
+    // a client runs its own movement ahead of ours, so a possible position replaces the one we worked out
+    bool corrected[MAX_PLAYERS];
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        corrected[i] = false;
+        if (!HasFlag(server, i, EntityIntegrated))
+            continue;
+
+        float budget = server->MoveBudget[i] + PlayerMoveSpeed * MoveSlack * deltaT;
+        if (budget > PlayerMoveSpeed * MoveBurst)
+            budget = PlayerMoveSpeed * MoveBurst;
+
+        if (server->PendingInput[i])
+        {
+            float x = server->ClaimX[i];
+            float y = server->ClaimY[i];
+
+            // off the field or further than they could have gone, keep our position and tell them where they really are
+            if (OnField(x, y) && MoveDistance(x - server->PreviousX[i], y - server->PreviousY[i]) <= budget)
+            {
+                players->X[i] = x;
+                players->Y[i] = y;
+            }
+            else
+            {
+                corrected[i] = true;
+                server->RejectedMoves++;
+            }
+        }
+
+        // every move costs budget, whether the client claimed it or we moved them
+        budget -= MoveDistance(players->X[i] - server->PreviousX[i], players->Y[i] - server->PreviousY[i]);
+        server->MoveBudget[i] = budget > 0 ? budget : 0;
+        server->PreviousX[i] = players->X[i];
+        server->PreviousY[i] = players->Y[i];
+    }
+
+    // the players who sent us something this tick have news for everyone else
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        if (!server->PendingInput[i])
+            continue;
+
+        server->PendingInput[i] = false;
+        server->Version[i]++;
+
+        uint8_t buffer[13] = { 0 };
+
+        // if they are new, everyone is sent an add player right away, the updates after that are scheduled
+        if (!HasFlag(server, i, EntityValidPosition))
+        {
+            // the player has sent us a position, they can be part of future regular updates
+            players->Flags[i] |= EntityValidPosition;
+
+            PackPlayer(server, AddPlayer, i, buffer);
+            SendToAllBut(server, buffer, 13, i);
+
+            for (int receiver = 0; receiver < MAX_PLAYERS; receiver++)
+                MarkSent(server, receiver, i);
+        }
+
+        // the player who sent it knows what they sent, so mark it sent to them
+        // and they get their own position back if we didn't believe theirs
+        MarkSent(server, i, i);
+        if (corrected[i])
+        {
+            PackPlayer(server, UpdatePlayer, i, buffer);
+            SendTo(server, server->Connections[i], buffer, 13);
+        }
+    }
+
+    ScheduleUpdates(server);
+}
+
+double NetServerUpdate(NetServer* server, double now)
+{
+    // the first update starts the clock
+    if (server->NextTick == 0)
+    {
+        server->LastTick = now;
+        server->NextTick = now + TickInterval;
+    }
+
+    if (now < server->NextTick)
+        return server->NextTick - now;
+
+    server->Tick++;
+    Tick(server, (float)(now - server->LastTick));
+    RecordHistory(server);
+    server->LastTick = now;
+
+    // stay on the tick schedule, unless we fell so far behind that it would mean running ticks back to back
+    server->NextTick += TickInterval;
+    if (server->NextTick <= now)
+        server->NextTick = now + TickInterval;
+
+    return server->NextTick - now;
+}
+
+bool NetServerRewind(NetServer* server, int playerId, uint32_t tick, NetVector2* position)
+{
+    if (playerId < 0 || playerId >= MAX_PLAYERS)
+        return false;
+
+    // ticks from the future are now, and ticks older than the history are the oldest one we kept
+    // the subtraction wraps the same way the tick counter does
+    if ((int32_t)(tick - server->Tick) > 0)
+        tick = server->Tick;
+    else if (server->Tick - tick >= HistoryTicks)
+        tick = server->Tick - (HistoryTicks - 1);
+
+    // the slot may not have been written yet if the server has only just started
+    int slot = tick % HistoryTicks;
+    if (server->HistoryTick[slot] != tick || !(server->HistoryFlags[slot][playerId] & EntityValidPosition))
+        return false;
+
+    position->x = server->HistoryX[slot][playerId];
+    position->y = server->HistoryY[slot][playerId];
+    return true;
+}
+
+uint32_t NetServerGetTick(NetServer* server)
+{
+    return server->Tick;
+}
+
+uint64_t NetServerRejectedMoves(NetServer* server)
+{
+    return server->RejectedMoves;
+}
+
+// FNV-1a over everything that makes up the game state
+uint64_t NetServerStateHash(NetServer* server)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        const NetEntityStore* players = server->Players;
+        int16_t values[] = { HasFlag(server, i, EntityActive), HasFlag(server, i, EntityValidPosition), (int16_t)server->Connections[i],
+            (int16_t)players->X[i], (int16_t)players->Y[i], (int16_t)players->DX[i], (int16_t)players->DY[i] };
+
+        const uint8_t* bytes = (const uint8_t*)values;
+        for (size_t b = 0; b < sizeof(values); b++)
+        {
+            hash ^= bytes[b];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    // the NPCs are always there, so only where they are and where they are going
+    for (int i = MAX_PLAYERS; i < MAX_PLAYERS + server->NPCCount; i++)
+    {
+        const NetEntityStore* players = server->Players;
+        int16_t values[] = { (int16_t)players->X[i], (int16_t)players->Y[i], (int16_t)players->DX[i], (int16_t)players->DY[i] };
+
+        const uint8_t* bytes = (const uint8_t*)values;
+        for (size_t b = 0; b < sizeof(values); b++)
+        {
+            hash ^= bytes[b];
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,97 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// The network server game play interface.
+// This is the server side game state and the handlers for what clients send us.
+// It does not know about enet or sockets, the program running it hands it events for each connection
+// and gives it a callback to send data with. This lets the same game play run in the real server and in tools (see tools/replay)
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "protocol.h"
+#include "netmath.h"
+
+// The server game state
+typedef struct NetServer NetServer;
+
+// Called when the server game play wants to send a message
+// the same data goes to every connection in the list, so the transport can share one packet between them
+typedef void (*NetServerSendCallback)(void* user, const uint16_t* connections, size_t connectionCount, const uint8_t* data, size_t length);
+
+// Called once a tick for each connection, returns how many bytes of position updates it can take this tick
+// it gets the same user pointer as the send callback
+typedef size_t (*NetServerBudgetCallback)(void* user, uint16_t connection);
+
+// create a server game state, all sends go through the callback
+// npcCount NPCs (up to MAX_NPCS) are put on the field with the entity ids after the players, the server moves them itself
+// from one random place to the next and they are sent to the players like any other entity, to load test with more than MAX_PLAYERS
+NetServer* NetServerCreate(NetServerSendCallback send, void* user, int npcCount);
+
+// Limit the position updates each connection gets to a byte budget per tick
+// every connection keeps a priority for every entity that grows each tick the entity has news it wasn't sent,
+// faster for entities that are close to the player and moving, and gets the highest ones that fit in its budget.
+// Without a budget callback every update goes to every connection
+void NetServerSetBudget(NetServer* server, NetServerBudgetCallback budget);
+
+// free a server game state
+void NetServerDestroy(NetServer* server);
+
+// A new connection was made
+// returns the player id they were given, or -1 if the server is full and they should be disconnected
+int NetServerConnect(NetServer* server, uint16_t connection);
+
+// A connection sent us a message
+// returns false if the connection is not one of our players and should be disconnected
+bool NetServerHandleMessage(NetServer* server, uint16_t connection, const NetMessage* message);
+
+// A connection was lost
+void NetServerDisconnect(NetServer* server, uint16_t connection);
+
+// Run the server simulation up to now, in seconds
+// once every tick the server moves the players itself, checks the positions they sent since the last tick
+// and tells everyone else where they are, a position that isn't possible is corrected instead of passed on
+// call this as often as you like, returns how many seconds until the next tick is due
+double NetServerUpdate(NetServer* server, double now);
+
+// Get where a player was at the end of a tick, for judging something a client did against what it was seeing
+// the server keeps about a second of ticks, older ticks give the oldest position kept and future ticks give the current one
+// returns false if the player had no position on that tick
+bool NetServerRewind(NetServer* server, int playerId, uint32_t tick, NetVector2* position);
+
+// The number of the last tick that ran, 0 before the first
+uint32_t NetServerGetTick(NetServer* server);
+
+// How many positions sent by players were not possible and were corrected
+uint64_t NetServerRejectedMoves(NetServer* server);
+
+// A hash of the whole game state, two servers that were given the same events will have the same hash
+uint64_t NetServerStateHash(NetServer* server);
@@ -0,0 +1,81 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// implementation of the shared protocol utilities
+
+#include "protocol.h"
+
+#include <string.h>
+
+uint8_t ReadByte(const NetMessage* message, size_t* offset)
+{
+    // make sure we have not gone past the end of the data we were sent
+    if (*offset + 1 > message->Length)
+        return 0;
+
+    // get the byte at the current offset
+    uint8_t data = message->Data[(*offset)];
+
+    // move the offset over 1 byte for the next read
+    *offset = *offset + 1;
+
+    return data;
+}
+
+int16_t ReadShort(const NetMessage* message, size_t* offset)
+{
+    // make sure we have not gone past the end of the data we were sent
+    if (*offset + 2 > message->Length)
+        return 0;
+
+    // copy the data out, the offset is not always aligned for a short
+    int16_t data = 0;
+    memcpy(&data, message->Data + (*offset), 2);
+
+    // move the offset over 2 bytes for the next read
+    *offset = (*offset) + 2;
+
+    return data;
+}
+
+uint32_t ReadInt(const NetMessage* message, size_t* offset)
+{
+    // make sure we have not gone past the end of the data we were sent
+    if (*offset + 4 > message->Length)
+        return 0;
+
+    // copy the data out, the offset is not always aligned for an int
+    uint32_t data = 0;
+    memcpy(&data, message->Data + (*offset), 4);
+
+    // move the offset over 4 bytes for the next read
+    *offset = (*offset) + 4;
+
+    return data;
+}
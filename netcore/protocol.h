@@ -0,0 +1,129 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// The game protocol shared by the client and the server.
+// This has the commands that can be sent over the network, the game constants both sides need to agree on
+// and the utility functions to read data out of a message.
+// It does not include enet so it can be used by anything that has the raw bytes of a message (including tools that never open a socket)
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// constants
+#define MAX_PLAYERS 8
+
+// the most NPCs a server can run, NPCs are entities the server moves itself, for load testing with more entities than players
+#define MAX_NPCS 100000
+
+// the most entities of any kind, players have the ids below MAX_PLAYERS and NPCs the ones after them
+#define MAX_ENTITIES (MAX_PLAYERS + MAX_NPCS)
+// how big the screen is for all players
+#define FieldSizeWidth 1280
+#define FieldSizeHeight  800
+
+// how big a player is
+#define PlayerSize 10
+
+// how fast a player can move, in pixels per second on each axis
+#define PlayerMoveSpeed 200
+
+// how fast an NPC moves, in pixels per second
+#define NPCMoveSpeed 60
+
+// how many simulation ticks the server runs a second, clients count ticks at the same rate to tell the server when they saw something
+#define ServerTickRate 30
+
+// how close a player has to be to tag someone, in pixels on each axis
+#define TagRange 20
+
+// the port the server listens on
+#define ServerPort 4545
+
+// All the different commands that can be sent over the network
+typedef enum
+{
+    // Server -> Client, You have been accepted. Contains the id for the client player to use and the server tick it was sent on
+    AcceptPlayer = 1,
+
+    // Server -> Client, Add a new player or NPC to your simulation, contains the 32 bit entity ID and a position
+    AddPlayer = 2,
+
+    // Server -> Client, Remove a player from your simulation, contains the 32 bit entity ID to remove
+    RemovePlayer = 3,
+
+    // Server -> Client, Update a player's or NPC's position in the simulation, contains the 32 bit entity ID and a position
+    UpdatePlayer = 4,
+
+    // Client -> Server, Provide an updated location for the client's player, contains the postion to update
+    UpdateInput = 5,
+
+    // Client -> Server, The client tagged a player, contains the ID of the player and the server tick the client was seeing when it did
+    TagPlayer = 6,
+
+    // Server -> Client, A tag was judged to be good, contains the ID of the player who tagged and the ID of the player who was tagged
+    PlayerTagged = 7,
+}NetworkCommands;
+
+// A read only view of the data in a message, this is what the read functions work on.
+// For messages from enet this is just the packet data and length
+typedef struct
+{
+    const uint8_t* Data;
+    size_t Length;
+}NetMessage;
+
+// Utility functions to read data out of a message
+
+/// <summary>
+/// Read one byte out of a message, from an offset, and update that offset to the next location to read from
+/// </summary>
+/// <param name="message">The message to read from</param>
+/// <param name="offset">A pointer to an offset that is updated, this should be passed to other read functions so they read from the correct place</param>
+/// <returns>The byte read, or 0 if the message is too short</returns>
+uint8_t ReadByte(const NetMessage* message, size_t* offset);
+
+/// <summary>
+/// Read a signed short from the message
+/// Note that this assumes the message is in the host's byte ordering
+/// In reality read/write code should use ntohs and htons to convert from network byte order to host byte order, so both big endian and little endian machines can play together
+/// </summary>
+/// <param name="message">The message to read from</param>
+/// <param name="offset">A pointer to an offset that is updated, this should be passed to other read functions so they read from the correct place</param>
+/// <returns>The signed short that is read, or 0 if the message is too short</returns>
+int16_t ReadShort(const NetMessage* message, size_t* offset);
+
+/// <summary>
+/// Read an unsigned 32 bit int from the message, in the host's byte ordering like ReadShort
+/// </summary>
+/// <param name="message">The message to read from</param>
+/// <param name="offset">A pointer to an offset that is updated, this should be passed to other read functions so they read from the correct place</param>
+/// <returns>The int that is read, or 0 if the message is too short</returns>
+uint32_t ReadInt(const NetMessage* message, size_t* offset);
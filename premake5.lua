@@ -4,6 +4,12 @@ newoption
    description = "use OpenGL 4.3"
 }
 
+newoption 
+{
+   trigger = "headless",
+   description = "only build the network core and the server, without raylib, for machines with no graphics"
+}
+
 workspace "NetTest"
 	configurations { "Debug","Debug.DLL", "Release", "Release.DLL" }
 	platforms { "x64", "x86"}
@@ -29,6 +35,7 @@ workspace "NetTest"
 		
 	targetdir "bin/%{cfg.buildcfg}/"
 
+if (not _OPTIONS["headless"]) then
 project "raylib"
 		filter "configurations:Debug.DLL OR Release.DLL"
 			kind "SharedLib"
@@ -68,7 +75,31 @@ project "raylib"
 			["Source Files/*"] = {"raylib/src/**.c"},
 		}
 		files {"raylib/src/*.h", "raylib/src/*.c"}
+end
+
+project "netcore"
+	kind "StaticLib"
+	location "netcore"
+	language "C"
+	targetdir "bin/%{cfg.buildcfg}"
+	
+	vpaths 
+	{
+		["Header Files"] = { "**.h"},
+		["Source Files"] = {"**.c", "**.cpp"},
+	}
+	files {"netcore/**.c", "netcore/**.h"}
+	
+	includedirs { "netcore", "include" }
+	
+	filter "action:vs*"
+		defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS", "_WIN32"}
+        characterset ("MBCS")
 		
+	filter "system:windows"
+		defines{"_WIN32"}
+		
+if (not _OPTIONS["headless"]) then
 project "client"
 	kind "ConsoleApp"
 	location "client"
@@ -83,9 +114,9 @@ project "client"
 	}
 	files {"client/**.c", "client/**.cpp", "client/**.h"}
 
-	links {"raylib"}
+	links {"raylib", "netcore"}
 	
-	includedirs { "client", "include", "raylib/src" }
+	includedirs { "client", "netcore", "raylib/src" }
 	
 	defines{"PLATFORM_DESKTOP"}
 	if (_OPTIONS["opengl43"]) then
@@ -96,8 +127,8 @@ project "client"
 	
 	filter "action:vs*"
 		defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS", "_WIN32"}
-		dependson {"raylib"}
-		links {"raylib.lib"}
+		dependson {"raylib", "netcore"}
+		links {"raylib.lib", "netcore.lib"}
         characterset ("MBCS")
 		
 	filter "system:windows"
@@ -107,7 +138,8 @@ project "client"
 		
 	filter "system:linux"
 		links {"pthread", "GL", "m", "dl", "rt", "X11"}
-		
+end
+
 project "server"
 	kind "ConsoleApp"
 	location "server"
@@ -122,27 +154,82 @@ project "server"
 	}
 	files {"server/**.c", "server/**.cpp", "server/**.h"}
 
-	links {"raylib"}
+	links {"netcore"}
 	
-	includedirs { "server", "include", "raylib/src" }
+	includedirs { "server", "netcore", "include" }
 	
-	defines{"PLATFORM_DESKTOP"}
-	if (_OPTIONS["opengl43"]) then
-		defines{"GRAPHICS_API_OPENGL_43"}
-	else
-		defines{"GRAPHICS_API_OPENGL_33"}
-	end
+	filter "action:vs*"
+		defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS", "_WIN32"}
+		dependson {"netcore"}
+		links {"netcore.lib"}
+        characterset ("MBCS")
+		
+	filter "system:windows"
+		defines{"_WIN32"}
+		links {"winmm", "kernel32", "Ws2_32"}
+		libdirs {"bin/%{cfg.buildcfg}"}
+		
+	filter "system:linux"
+		links {"pthread", "m", "rt"}
+		
+project "replay"
+	kind "ConsoleApp"
+	location "tools/replay"
+	language "C"
+	targetdir "bin/%{cfg.buildcfg}"
+	
+	vpaths 
+	{
+		["Header Files"] = { "**.h"},
+		["Source Files"] = {"**.c", "**.cpp"},
+	}
+	files {"tools/replay/**.c", "tools/replay/**.h"}
+
+	links {"netcore"}
+	
+	includedirs { "tools/replay", "netcore" }
 	
 	filter "action:vs*"
 		defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS", "_WIN32"}
-		dependson {"raylib"}
-		links {"raylib.lib"}
+		dependson {"netcore"}
+		links {"netcore.lib"}
         characterset ("MBCS")
 		
 	filter "system:windows"
 		defines{"_WIN32"}
-		links {"winmm", "kernel32", "opengl32", "kernel32", "gdi32", "Ws2_32"}
+		links {"winmm", "kernel32", "Ws2_32"}
+		libdirs {"bin/%{cfg.buildcfg}"}
+		
+	filter "system:linux"
+		links {"pthread", "m", "rt"}
+
+project "checksum"
+	kind "ConsoleApp"
+	location "tools/checksum"
+	language "C"
+	targetdir "bin/%{cfg.buildcfg}"
+	
+	vpaths 
+	{
+		["Header Files"] = { "**.h"},
+		["Source Files"] = {"**.c", "**.cpp"},
+	}
+	files {"tools/checksum/**.c", "tools/checksum/**.h"}
+
+	links {"netcore"}
+	
+	includedirs { "tools/checksum", "netcore", "include" }
+	
+	filter "action:vs*"
+		defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS", "_WIN32"}
+		dependson {"netcore"}
+		links {"netcore.lib"}
+        characterset ("MBCS")
+		
+	filter "system:windows"
+		defines{"_WIN32"}
+		links {"winmm", "kernel32", "Ws2_32"}
 		libdirs {"bin/%{cfg.buildcfg}"}
 		
 	filter "system:linux"
-		links {"pthread", "GL", "m", "dl", "rt", "X11"}
\ No newline at end of file
+		links {"pthread", "m", "rt"}
@@ -28,7 +28,6 @@
 
 // server code
 
-// ensure we are using winsock2 on windows.
 // ensure we are using winsock2 on windows.
 #if (_WIN32_WINNT < 0x0601)
 	#undef _WIN32_WINNT
@@ -36,144 +35,102 @@
 #endif
 
 // include the network layer from enet (https://github.com/zpl-c/enet)
-#define ENET_IMPLEMENTATION
+// the implementation itself is compiled once in the network core (netcore/enet.c)
 #include "enet.h"
 
+// the server game play and packet capture from the network core
+#include "netserver.h"
+#include "capture.h"
+#include "compress.h"
+#include "linksim.h"
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+#include <signal.h>
 
 // max number of players
-#define MAX_CLIENTS 8
-
-// All the different commands that can be sent over the network
-typedef enum
-{
-    // Server -> Client, You have been accepted. Contains the id for the client player to use
-    AcceptPlayer = 1,
+#define MAX_CLIENTS MAX_PLAYERS
 
-    // Server -> Client, Add a new player to your simulation, contains the ID of the player and a position
-    AddPlayer = 2,
+// the enet host all the players connect to
+ENetHost* Host = NULL;
 
-    // Server -> Client, Remove a player from your simulation, contains the ID of the player to remove
-    RemovePlayer = 3,
+// where we record all the traffic, if capturing was asked for on the command line
+NetCapture* Capture = NULL;
 
-    // Server -> Client, Update a player's position in the simulation, contains the ID of the player and a position
-    UpdatePlayer = 4,
+// the simulated link in front of our host, if one was asked for on the command line
+NetLinkSim* Link = NULL;
 
-    // Client -> Server, Provide an updated location for the client's player, contains the postion to update
-    UpdateInput = 5,
-}NetworkCommands;
+// the group our host waits in, so anything can wake the main loop up without waiting for the timeout
+ENetHostGroup* Group = NULL;
 
+// set when the process is asked to stop, checked by the main loop
+volatile sig_atomic_t StopRequested = 0;
 
-// the info we are tracking about each player in the game
-typedef struct
+// ctrl+c or a kill asks the server to stop
+// only set a flag and wake the wait here, the main loop does the actual shutdown so the capture is flushed
+void HandleStopSignal(int signalNumber)
 {
-    // is this player slot active
-    bool Active;
-
-    // have they sent us a valid position yet?
-    bool ValidPosition;
-
-    // the network connection they use
-    ENetPeer* Peer;
-
-    // the last known location in X and Y
-    int16_t X;
-    int16_t Y;
-
-    int16_t DX;
-    int16_t DY;
-}PlayerInfo;
-
-
-// The list of all possible players
-// this is the server state of the game that represents the current game state
-// this is what server code would check to see where all the players are and what they are doing
-PlayerInfo Players[MAX_CLIENTS] = { 0 };
-
-// Utility functions to read data out of a packet
-// Optimally this would go into a library that was shared by the client and the server
+    (void)signalNumber;
+    StopRequested = 1;
+    enet_host_group_wake(Group);
+}
 
-/// <summary>
-/// Read one byte out of a packet, from an offset, and update that offset to the next location to read from
-/// </summary>
-/// <param name="packet">The packet to read from</param>
-/// <param name="offset">A pointer to an offset that is updated, this should be passed to other read functions so they read from the correct place</param>
-/// <returns>The byte read</returns>
-uint8_t ReadByte(ENetPacket* packet, size_t* offset)
+// The game play wants to send some data to some players
+// copy it into one enet packet and queue it up for all of them, enet reference counts the packet
+void SendToConnections(void* user, const uint16_t* connections, size_t connectionCount, const uint8_t* data, size_t length)
 {
-    // make sure we have not gone past the end of the data we were sent
-    if (*offset > packet->dataLength)
-        return 0;
+    (void)user;
 
-    // cast the data to a byte so we can increment it in 1 byte chunks
-    uint8_t* ptr = (uint8_t*)packet->data;
+    // copy the buffer into an enet packet (TODO : add write functions to go directly to a packet)
+    ENetPacket* packet = enet_packet_create(data, length, ENET_PACKET_FLAG_RELIABLE);
 
-    // get the byte at the current offset
-    uint8_t data = ptr[(*offset)];
-
-    // move the offset over 1 byte for the next read
-    *offset = *offset + 1;
+    for (size_t i = 0; i < connectionCount; i++)
+    {
+        NetCaptureWrite(Capture, connections[i], CaptureSent, data, length);
+        enet_peer_send(&Host->peers[connections[i]], 0, packet);
+    }
 
-    return data;
+    // NOTE enet_host_service will handle releasing send packets when the network system has finally sent them,
+    // you don't have to destroy them
 }
 
-/// <summary>
-/// Read a signed short from the network packet
-/// Note that this assumes the packet is in the host's byte ordering
-/// In reality read/write code should use ntohs and htons to convert from network byte order to host byte order, so both big endian and little endian machines can play together
-/// </summary>
-/// <param name="packet">The packet to read from<</param>
-/// <param name="offset">A pointer to an offset that is updated, this should be passed to other read functions so they read from the correct place</param>
-/// <returns>The signed short that is read</returns>
-int16_t ReadShort(ENetPacket* packet, size_t* offset)
+// How many bytes of position updates a connection can take this tick
+// a client that told us its downstream bandwidth gets no more than that, and no connection gets more than its window of
+// reliable data carries in a round trip. Both are cut back by enet's throttle while packets are being lost,
+// and nothing is sent while the window is full of data that hasn't been acknowledged, so updates wait instead of queuing up
+size_t ConnectionBudget(void* user, uint16_t connection)
 {
-    // make sure we have not gone past the end of the data we were sent
-    if (*offset > packet->dataLength)
-        return 0;
+    (void)user;
+    ENetPeer* peer = &Host->peers[connection];
 
-    // cast the data to a byte at the offset
-    uint8_t* data = (uint8_t*)packet->data;
-    data += (*offset);
+    enet_uint32 window = Host->congestionControl.context != NULL ? peer->congestionWindow : peer->windowSize;
+    enet_uint64 rate = (enet_uint64)window * 1000 / (peer->roundTripTime > 0 ? peer->roundTripTime : 1);
+    if (peer->incomingBandwidth != 0 && peer->incomingBandwidth < rate)
+        rate = peer->incomingBandwidth;
 
-    // move the offset over 2 bytes for the next read
-    *offset = (*offset) + 2;
+    rate = rate * peer->packetThrottle / ENET_PEER_PACKET_THROTTLE_SCALE;
 
-    // cast the data pointer to a short and return a copy
-    return *(int16_t*)data;
-}
-
-// finds the player slot that goes with the player connection
-// the peer has the void* ENetPeer::data that can be used to store arbitary application data
-// but that involves managing structure pointers so it is kept out of this example
-int GetPlayerId(ENetPeer* peer)
-{
-    // find the slot that matches the pointer
-    for (int i = 0; i < MAX_CLIENTS; i++)
-    {
-        if (Players[i].Active && Players[i].Peer == peer)
-            return i;
-    }
-    return -1;
-}
-
-// sends a packet over the network to every active player, except the one specified (usually the sender)
-// senders know what they sent so you can choose to not send them data they already know.
-// in a truly authoritive server you'd send back an acceptance message to all client input so they know it wasn't rejected.
-void SendToAllBut(ENetPacket* packet, int exceptPlayerId)
-{
-    for (int i = 0; i < MAX_CLIENTS; i++)
-    {
-        if (!Players[i].Active || i == exceptPlayerId)
-            continue;
+    enet_uint64 budget = rate / ServerTickRate;
+    enet_uint64 room = window > peer->reliableDataInTransit ? window - peer->reliableDataInTransit : 0;
+    if (room < budget)
+        budget = room;
 
-        enet_peer_send(Players[i].Peer, 0, packet);
-    }
+    // the budget depends on the network, so a replay has to be told what it was
+    NetCaptureWrite(Capture, connection, CaptureBudget, (const uint8_t*)&budget, sizeof(budget));
+    return (size_t)budget;
 }
 
 // the main server loop
-int main()
+// pass --capture <file> to record all the game traffic to a file that can be replayed with tools/replay
+// pass --uring to move the server's packets with io_uring on Linux
+// pass --us-clock to measure round trip times in microseconds
+// pass --delay-cc to back off sending to a client as soon as its link starts queuing, instead of after losses
+// pass --link <conditions> to send through a simulated bad network, like --link latency=100,jitter=20,loss=0.05,seed=1
+// pass --npcs <count> to put that many server moved NPCs on the field, up to MAX_NPCS, for load testing
+int main(int argc, char** argv)
 {
     printf("Startup\n");
 
@@ -183,32 +140,141 @@ int main()
 
     printf("Initialized\n");
 
+    ENetHostTransport transport = ENET_HOST_TRANSPORT_SOCKET;
+    ENetHostClock clockMode = ENET_HOST_CLOCK_MILLISECONDS;
+    bool delayControl = false;
+    bool simulateLink = false;
+    NetLinkConditions linkConditions = { 0 };
+    int npcs = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+        {
+            Capture = NetCaptureOpen(argv[i + 1]);
+            if (Capture == NULL)
+                printf("Unable to open capture file %s\n", argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--uring") == 0)
+        {
+            transport = ENET_HOST_TRANSPORT_URING;
+        }
+        else if (strcmp(argv[i], "--us-clock") == 0)
+        {
+            clockMode = ENET_HOST_CLOCK_MICROSECONDS;
+        }
+        else if (strcmp(argv[i], "--delay-cc") == 0)
+        {
+            delayControl = true;
+        }
+        else if (strcmp(argv[i], "--link") == 0 && i + 1 < argc)
+        {
+            simulateLink = NetLinkParse(argv[i + 1], &linkConditions);
+            if (!simulateLink)
+                printf("Unable to read link conditions %s\n", argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--npcs") == 0 && i + 1 < argc)
+        {
+            npcs = atoi(argv[i + 1]);
+            if (npcs < 0 || npcs > MAX_NPCS)
+            {
+                npcs = npcs < 0 ? 0 : MAX_NPCS;
+                printf("NPC count %s is not between 0 and %d, using %d\n", argv[i + 1], MAX_NPCS, npcs);
+            }
+        }
+    }
+
     // network servers must 'listen' on an interface and a port
     // this code sets up enet to listen on any available interface and using our port
     // the client must use the same port as the server and know the address of the server
     ENetAddress address = { 0 };
     address.host = ENET_HOST_ANY;
-    address.port = 4545;
+    address.port = ServerPort;
 
     // create the server host
-    ENetHost* server = enet_host_create(&address, MAX_CLIENTS, 1, 0, 0);
+    Host = enet_host_create_transport(&address, MAX_CLIENTS, 1, 0, 0, transport);
+
+    if (Host == NULL)
+        return 1;
+
+    // checksum every datagram so corrupted ones are dropped instead of reaching the game play
+    // the client does the same, both ends have to agree on the checksum
+    Host->checksum = enet_crc32;
+
+    // compress datagrams with the dictionary trained on game traffic, the client uses the same one
+    if (!NetCompressAttach(Host, NetCompressGameDictionary, NetCompressGameDictionarySize))
+        return 1;
+
+    // on a LAN millisecond round trip times round to 0 or 1, so retransmission timeouts can be estimated in microseconds
+    enet_host_clock(Host, clockMode);
+
+    // the delay based congestion control paces each client by its round trip time and keeps queuing delay low
+    if (delayControl && enet_host_congestion_control_delay(Host, 0) != 0)
+        return 1;
+
+    // game messages are handled and destroyed as soon as they arrive, so read them straight out of the receive buffers
+    // io_uring hosts keep their buffers posted to the kernel and go on copying
+    enet_host_zero_copy(Host, 1);
+
+    // io_uring falls back to plain sockets where the kernel doesn't have it
+    if (transport == ENET_HOST_TRANSPORT_URING && enet_host_get_transport(Host) != ENET_HOST_TRANSPORT_URING)
+        printf("io_uring is not available, using sockets\n");
+
+    // everything we send goes through the simulated link, it holds datagrams back so the wait below has to wake up for them
+    if (simulateLink)
+        Link = NetLinkSimAttach(Host, &linkConditions);
+
+    // put the host in a group so the stop signal can wake it
+    Group = enet_host_group_create();
+    if (Group == NULL || enet_host_group_add(Group, Host) != 0)
+        return 1;
+
+    signal(SIGINT, HandleStopSignal);
+    signal(SIGTERM, HandleStopSignal);
+
+    // create the game state, it sends everything back through our enet host
+    NetServer* server = NetServerCreate(SendToConnections, NULL, npcs);
 
     if (server == NULL)
         return 1;
 
+    // updates to each client are limited to what its connection can carry
+    NetServerSetBudget(server, ConnectionBudget);
+
     printf("Created\n");
 
-    // the server will run forever. If we wanted a way to stop it, we'd set run to false using some code
-    bool run = true;
+    // the first update starts the simulation clock
+    bool clockStarted = false;
 
-    while (run)
+    // the server runs until it gets ctrl+c or is killed
+    while (!StopRequested)
     {
         ENetEvent event = { 0 };
 
-        // see if there are any inbound network events, wait up to 1000ms before returning.
-        // if the server also did game logic, this timeout should be lowered
-        if (enet_host_service(server, &event, 1000) > 0)
+        // run the game simulation, it ticks when a tick is due and tells us how long until the next one
+        double now = NetCaptureClock() / 1000000000.0;
+        uint32_t lastTick = NetServerGetTick(server);
+        double tickWait = NetServerUpdate(server, now);
+
+        // record when the simulation clock started and when every tick ran, so a replay runs the same ticks at the same times
+        if (!clockStarted || NetServerGetTick(server) != lastTick)
+            NetCaptureWrite(Capture, 0, CaptureTick, (const uint8_t*)&now, sizeof(now));
+        clockStarted = true;
+
+        // see if there are any inbound network events, wait until the next simulation tick before returning.
+        // a wake from the stop signal returns 0 right away
+        // a simulated link shortens the wait to when its next held datagram is due
+        int serviceResult = enet_host_service(Host, &event, NetLinkSimUpdate(Link, (uint32_t)(tickWait * 1000) + 1));
+
+        // when things are quiet make sure the capture is on disk, so it is usable even if the server is killed
+        if (serviceResult == 0)
+            NetCaptureFlush(Capture);
+
+        if (serviceResult > 0)
         {
+            // the peer's slot in the host is the connection id the game play knows the player by
+            uint16_t connection = event.peer->incomingPeerID;
+
             // see what kind of event we have
             switch (event.type)
             {
@@ -217,65 +283,13 @@ int main()
             case ENET_EVENT_TYPE_CONNECT:
             {
                 printf("Player Connected\n");
+                NetCaptureWrite(Capture, connection, CaptureConnected, NULL, 0);
 
-                // find an empty slot, or disconnect them if we are full
-                int playerId = 0;
-                for (; playerId < MAX_CLIENTS; playerId++)
-                {
-                    if (!Players[playerId].Active)
-                        break;
-                }
-
-                // we are full
-                if (playerId == MAX_CLIENTS)
+                // find them a slot, or disconnect them if we are full
+                if (NetServerConnect(server, connection) == -1)
                 {
                     // I said good day SIR!
                     enet_peer_disconnect(event.peer, 0);
-                    break;
-                }
-
-                // player is good, don't give away the slot
-                Players[playerId].Active = true;
-
-                // but don't send out an update to everyone until they give us a good position
-                Players[playerId].ValidPosition = false;
-                Players[playerId].Peer = event.peer;
-
-                // pack up a message to send back to the client to tell them they have been accepted as a player
-                uint8_t buffer[2] = { 0 };
-                buffer[0] = (uint8_t)AcceptPlayer;  // command for the client
-                buffer[1] = (uint8_t)playerId;      // the player ID so they know who they are
-
-                // copy the buffer into an enet packet (TODO : add write functions to go directly to a packet)
-                ENetPacket* packet = enet_packet_create(buffer, 2, ENET_PACKET_FLAG_RELIABLE);
-                // send the data to the user
-                enet_peer_send(event.peer, 0, packet);
-
-                // We have to tell the new client about all the other players that are already on the server
-                // so send them an add message for all existing active players.
-                for (int i = 0; i < MAX_CLIENTS; i++)
-                {
-                    // only people who are valid and not the new player
-                    if (i == playerId || !Players[i].ValidPosition)
-                        continue;
-
-                    // pack up an add player message with the ID and the last known position
-                    uint8_t addBuffer[10] = { 0 };
-                    addBuffer[0] = (uint8_t)AddPlayer;
-                    addBuffer[1] = (uint8_t)i;
-                    *(int16_t*)(addBuffer + 2) = (int16_t)Players[i].X;
-                    *(int16_t*)(addBuffer + 4) = (int16_t)Players[i].Y;
-                    *(int16_t*)(addBuffer + 6) = (int16_t)Players[i].DX;
-                    *(int16_t*)(addBuffer + 8) = (int16_t)Players[i].DY;
-
-                    // Optimally we'd also send other info like name, color, and other static player info.
-
-                    // copy and send the message
-                    packet = enet_packet_create(addBuffer, 10, ENET_PACKET_FLAG_RELIABLE);
-                    enet_peer_send(event.peer, 0, packet);
-
-                    // NOTE enet_host_service will handle releasing send packets when the network system has finally sent them,
-                    // you don't have to destroy them
                 }
                 break;
             }
@@ -283,60 +297,13 @@ int main()
             // someone sent us data
             case ENET_EVENT_TYPE_RECEIVE:
             {
-                // find the player who sent the data
-                // we don't need them to send us what ID they are, we know who they are by the peer
-                // we want to trust the client as little as possible so that people can't cheat/hack
-                // if we blindly accepted a player ID, a client could send you updates for someone else :(
+                NetMessage message = { event.packet->data, event.packet->dataLength };
+                NetCaptureWrite(Capture, connection, CaptureReceived, message.Data, message.Length);
 
-                int playerId = GetPlayerId(event.peer);
-                if (playerId == -1)
+                if (!NetServerHandleMessage(server, connection, &message))
                 {
                     // they are not one of our peeple, boot them
                     enet_peer_disconnect(event.peer, 0);
-                    break;
-                }
-
-                // keep track of how far into the message we are
-                size_t offset = 0;
-
-                // read off the command the client wants us to process
-                NetworkCommands command = ReadByte(event.packet, &offset);
-
-                // we only accept one message from clients for now, so make sure this is what it is
-                if (command == UpdateInput)
-                {
-                    // update the location data with the new info
-                    Players[playerId].X = ReadShort(event.packet, &offset);
-                    Players[playerId].Y = ReadShort(event.packet, &offset);
-                    Players[playerId].DX = ReadShort(event.packet, &offset);
-                    Players[playerId].DY = ReadShort(event.packet, &offset);
-
-                    // lets tell everyone about this new location
-                    NetworkCommands outboundCommand = UpdatePlayer;
-
-                    // if they are new, send this update as an add player instead of an update
-                    if (!Players[playerId].ValidPosition)
-                        outboundCommand = AddPlayer;
-
-                    // the player has sent us a position, they can be part of future regular updates
-                    Players[playerId].ValidPosition = true;
-
-                    // pack up the update message with command, player and position
-                    uint8_t buffer[10] = { 0 };
-                    buffer[0] = (uint8_t)outboundCommand;
-                    buffer[1] = (uint8_t)playerId;
-                    *(int16_t*)(buffer + 2) = (int16_t)Players[playerId].X;
-                    *(int16_t*)(buffer + 4) = (int16_t)Players[playerId].Y;
-                    *(int16_t*)(buffer + 6) = (int16_t)Players[playerId].DX;
-                    *(int16_t*)(buffer + 8) = (int16_t)Players[playerId].DY;
-
-
-                    // Copy and send the data to everyone but the player who sent it  (TODO : add write functions to go directly to a packet)
-                    ENetPacket* packet = enet_packet_create(buffer, 10, ENET_PACKET_FLAG_RELIABLE);
-                    SendToAllBut(packet, playerId);
-
-                    // NOTE enet_host_service will handle releasing send packets when the network system has finally sent them,
-                    // you don't have to destroy them
                 }
 
                 // tell enet that it can recycle the inbound packet
@@ -348,28 +315,10 @@ int main()
             {
                 // a player was disconnected
                 printf("Player Disconnected\n");
-                
-                // find them if they are a real player
-                int playerId = GetPlayerId(event.peer);
-                if (playerId == -1)
-                    break;
-
-                // mark them as inactive and clear the peer pointer
-                Players[playerId].Active = false;
-                Players[playerId].Peer = NULL;
-
-                // Tell everyone that someone left
-                uint8_t buffer[2] = { 0 };
-                buffer[0] = (uint8_t)RemovePlayer;
-                buffer[1] = (uint8_t)playerId;
-
-                // Copy and send the data to everyone but the player who sent it  (TODO : add write functions to go directly to a packet)
-                ENetPacket* packet = enet_packet_create(buffer, 2, ENET_PACKET_FLAG_RELIABLE);
-                SendToAllBut(packet, -1);
-
-                // NOTE enet_host_service will handle releasing send packets when the network system has finally sent them,
-                   // you don't have to destroy them
+                NetCaptureWrite(Capture, connection, CaptureDisconnected, NULL, 0);
 
+                // the game play tells everyone that someone left
+                NetServerDisconnect(server, connection);
                 break;
             }
 
@@ -379,9 +328,39 @@ int main()
         }
     }
 
+    printf("Shutdown\n");
+    printf("Rejected moves: %llu\n", (unsigned long long)NetServerRejectedMoves(server));
+
+    // report what compression saved and what it cost
+    NetCompressStats compression;
+    if (NetCompressGetStats(Host, &compression) && compression.BytesOut > 0)
+    {
+        printf("Compression: %llu datagrams (%llu sent as they were) %llu bytes -> %llu bytes, ratio %.3f, %.2f ns/byte compress, %.2f ns/byte decompress\n",
+            (unsigned long long)compression.Datagrams, (unsigned long long)compression.Skipped,
+            (unsigned long long)compression.BytesIn, (unsigned long long)compression.BytesOut,
+            (double)compression.BytesIn / (double)compression.BytesOut,
+            compression.BytesIn > 0 ? (double)compression.CompressNanoseconds / (double)compression.BytesIn : 0.0,
+            compression.BytesDecompressed > 0 ? (double)compression.DecompressNanoseconds / (double)compression.BytesDecompressed : 0.0);
+    }
+
+    // report what the simulated link did to our traffic
+    if (Link != NULL)
+    {
+        NetLinkStats link;
+        NetLinkSimGetStats(Link, &link);
+        printf("Link: %llu sent, %llu lost, %llu over the queue limit, %llu duplicated, %llu reordered, %llu received, %llu lost inbound\n",
+            (unsigned long long)link.Sent, (unsigned long long)link.Lost, (unsigned long long)link.Overflowed,
+            (unsigned long long)link.Duplicated, (unsigned long long)link.Reordered,
+            (unsigned long long)link.Received, (unsigned long long)link.InboundLost);
+    }
+
     // cleanup
-    enet_host_destroy(server);
+    NetServerDestroy(server);
+    NetCaptureClose(Capture);
+    NetLinkSimDetach(Link);
+    enet_host_destroy(Host);
+    enet_host_group_destroy(Group);
     enet_deinitialize();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,246 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+
+// Checksum benchmark
+// Times the checksums enet can put on every datagram (ENetHost::checksum) against the original
+// byte at a time CRC-32 loop, on datagram sized buffers split the way enet sends them (header, commands, payload).
+// Every implementation is checked first, enet_crc32 against the original loop and the hardware enet_crc32c against
+// its slice-by-8, on every length, at odd alignments and split across buffers in several places. A checksum has to give the same result whichever CPU features
+// it uses or peers could not talk to each other.
+//
+// usage: checksum [--iterations <count>]
+
+// ensure we are using winsock2 on windows.
+#if (_WIN32_WINNT < 0x0601)
+	#undef _WIN32_WINNT
+    #define _WIN32_WINNT 0x0601
+#endif
+
+#include "enet.h"
+#include "capture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// the datagram sizes we time, from a bare acknowledgement up to a full sized fragment
+static const size_t DatagramSizes[] = { 16, 64, 256, 1400, 4096 };
+#define DatagramSizeCount (sizeof(DatagramSizes) / sizeof(DatagramSizes[0]))
+
+// the largest datagram enet sends
+#define MaxDatagramSize 4096
+
+// enet_crc32 before it was sped up, one table lookup per byte
+static uint32_t ReferenceTable[256];
+
+void InitReferenceCRC32()
+{
+    for (uint32_t byte = 0; byte < 256; byte++)
+    {
+        uint32_t crc = byte;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+
+        ReferenceTable[byte] = crc;
+    }
+}
+
+enet_uint32 ReferenceCRC32(const ENetBuffer* buffers, size_t bufferCount)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < bufferCount; i++)
+    {
+        const uint8_t* data = (const uint8_t*)buffers[i].data;
+        for (size_t j = 0; j < buffers[i].dataLength; j++)
+            crc = (crc >> 8) ^ ReferenceTable[(crc ^ data[j]) & 0xFF];
+    }
+
+    return ENET_HOST_TO_NET_32(~crc);
+}
+
+// split a datagram into three buffers, the first two as long as asked for (or what is left of the datagram)
+size_t SplitDatagramAt(uint8_t* data, size_t length, size_t first, size_t second, ENetBuffer* buffers)
+{
+    size_t header = length < first ? length : first;
+    size_t command = length - header < second ? length - header : second;
+
+    buffers[0].data = data;
+    buffers[0].dataLength = header;
+    buffers[1].data = data + header;
+    buffers[1].dataLength = command;
+    buffers[2].data = data + header + command;
+    buffers[2].dataLength = length - header - command;
+    return 3;
+}
+
+// split a datagram into buffers the way enet hands them to the checksum: a 4 byte header, the command, then the payload
+size_t SplitDatagram(uint8_t* data, size_t length, ENetBuffer* buffers)
+{
+    return SplitDatagramAt(data, length, 4, 12, buffers);
+}
+
+// the buffer layouts checked, enet's own, everything in one buffer, empty buffers, and boundaries that land
+// inside and on the edges of the 64 byte blocks the pclmul fold works on, so the crc is carried over mid block
+static const size_t Splits[][2] = { { 4, 12 }, { 0, 0 }, { 0, 1 }, { 1, 0 }, { 4, 60 }, { 37, 50 }, { 63, 2 }, { 64, 64 }, { 70, 129 }, { 200, 1 } };
+#define SplitCount (sizeof(Splits) / sizeof(Splits[0]))
+
+// one checksum to time, with the cpu features it is allowed to use
+// and what it has to match, run with no cpu features, NULL for the ones that are a reference themselves
+typedef struct
+{
+    const char* Name;
+    ENetChecksumCallback Checksum;
+    enet_uint32 Features;
+    ENetChecksumCallback Reference;
+}ChecksumCase;
+
+// check a checksum against its reference on every length up to a full datagram, at odd alignments and split up every way in Splits
+bool Verify(const ChecksumCase* test, const uint8_t* data)
+{
+    for (size_t length = 0; length <= MaxDatagramSize; length++)
+    {
+        for (size_t split = 0; split < SplitCount; split++)
+        {
+            size_t offset = (length + split) % 7;
+            ENetBuffer buffers[3];
+            size_t bufferCount = SplitDatagramAt((uint8_t*)data + offset, length, Splits[split][0], Splits[split][1], buffers);
+
+            enet_checksum_features(0);
+            enet_uint32 expected = test->Reference(buffers, bufferCount);
+
+            enet_checksum_features(test->Features);
+            if (test->Checksum(buffers, bufferCount) != expected)
+            {
+                printf("%s does not match the reference at %d bytes split %d/%d\n", test->Name, (int)length, (int)Splits[split][0], (int)Splits[split][1]);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 200000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = atoi(argv[++i]);
+    }
+
+    if (iterations < 1)
+        iterations = 1;
+
+    InitReferenceCRC32();
+
+    // some data to checksum, the contents don't matter
+    static uint8_t data[MaxDatagramSize + 8];
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+
+    enet_uint32 supported = enet_checksum_features(ENET_CHECKSUM_FEATURE_PCLMUL | ENET_CHECKSUM_FEATURE_SSE42);
+    printf("cpu supports:%s%s\n", (supported & ENET_CHECKSUM_FEATURE_PCLMUL) ? " pclmul" : "", (supported & ENET_CHECKSUM_FEATURE_SSE42) ? " sse4.2" : "");
+
+    ChecksumCase cases[] =
+    {
+        { "reference crc32", ReferenceCRC32, 0, NULL },
+        { "crc32 slice-by-8", enet_crc32, 0, ReferenceCRC32 },
+        { "crc32 pclmul", enet_crc32, ENET_CHECKSUM_FEATURE_PCLMUL, ReferenceCRC32 },
+        { "crc32c slice-by-8", enet_crc32c, 0, NULL },
+        { "crc32c sse4.2", enet_crc32c, ENET_CHECKSUM_FEATURE_SSE42, enet_crc32c },
+    };
+    size_t caseCount = sizeof(cases) / sizeof(cases[0]);
+
+    // the standard check value, "123456789" gives CBF43926 for CRC-32 and E3069283 for CRC-32C
+    ENetBuffer check;
+    check.data = (void*)"123456789";
+    check.dataLength = 9;
+    for (size_t i = 0; i < 2; i++)
+    {
+        enet_checksum_features(i == 0 ? 0 : supported);
+        if (ENET_NET_TO_HOST_32(enet_crc32(&check, 1)) != 0xCBF43926 || ENET_NET_TO_HOST_32(enet_crc32c(&check, 1)) != 0xE3069283)
+        {
+            printf("check value mismatch\n");
+            return 2;
+        }
+    }
+
+    // crc32 has to match the original loop, crc32c is a different polynomial so its hardware path is checked against its own slice-by-8
+    // the slice-by-8 crc32c only has the check value above to go on
+    for (size_t i = 0; i < caseCount; i++)
+    {
+        if (cases[i].Reference != NULL && !Verify(&cases[i], data))
+            return 2;
+    }
+
+    printf("%-20s", "bytes");
+    for (size_t size = 0; size < DatagramSizeCount; size++)
+        printf("%10d", (int)DatagramSizes[size]);
+    printf("   (ns per datagram)\n");
+
+    for (size_t i = 0; i < caseCount; i++)
+    {
+        // skip what this cpu can't do, it would just time the fallback again
+        if ((cases[i].Features & supported) != cases[i].Features)
+            continue;
+
+        enet_checksum_features(cases[i].Features);
+        printf("%-20s", cases[i].Name);
+
+        for (size_t size = 0; size < DatagramSizeCount; size++)
+        {
+            ENetBuffer buffers[3];
+            size_t bufferCount = SplitDatagram(data, DatagramSizes[size], buffers);
+            enet_uint32 sink = 0;
+
+            uint64_t start = NetCaptureClock();
+            for (int iteration = 0; iteration < iterations; iteration++)
+            {
+                // vary the first byte so the work can't be hoisted out of the loop
+                data[0] = (uint8_t)iteration;
+                sink ^= cases[i].Checksum(buffers, bufferCount);
+            }
+            uint64_t elapsed = NetCaptureClock() - start;
+
+            printf("%10.1f", (double)elapsed / (double)iterations + (sink == 0x12345678 ? 0.0001 : 0.0));
+        }
+        printf("\n");
+    }
+
+    enet_checksum_features(supported);
+    return 0;
+}
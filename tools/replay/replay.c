@@ -0,0 +1,458 @@
+/**********************************************************************************************
+*
+*   raylib_networking_smaple * a sample network game using raylib and enet
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2021 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+// Capture replay tool
+// This maps a capture made by the client or the server (--capture <file>) and feeds every message in it
+// through the client or server game play with no sockets, as fast as it can.
+// It reports how long each message took to handle and a hash of the final game state,
+// so real traffic can be used as a repeatable benchmark and as a regression check (the hash should not change unless the game play did)
+//
+// It can also measure how well the datagram compressor does on the traffic in the capture, and train a new dictionary from it.
+//
+// usage: replay <capture file> [--client] [--iterations <count>] [--npcs <count>] [--compress] [--train <dictionary source file>]
+//   --client       the capture was made by a client, replay it through the client game play instead of the server
+//   --iterations   how many times to replay the whole capture, for more stable timings
+//   --npcs         how many NPCs the server that made the capture had, so the replay moves the same ones
+//   --compress     report the compression ratio and speed on the messages in the capture, with and without the game dictionary
+//   --train        train a dictionary on the messages in the capture and write it out as C source (netcore/compress_dictionary.c)
+
+#include "capture.h"
+#include "compress.h"
+#include "netclient.h"
+#include "netserver.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// what the replay did
+typedef struct
+{
+    // messages (and connects/disconnects) that went through the game play
+    uint64_t Handled;
+
+    // messages the capture says were sent, and how many the game play sent during the replay
+    uint64_t RecordedSends;
+    uint64_t ReplayedSends;
+
+    // how long handling took
+    uint64_t Nanoseconds;
+
+    uint64_t Hash;
+}ReplayStats;
+
+// the budget each connection was given on the tick being replayed, from the budget records, indexed by connection
+static size_t RecordedBudgets[65536];
+
+// the server game play asks for budgets here, and gets what the live server's connections had
+size_t RecordedBudget(void* user, uint16_t connection)
+{
+    (void)user;
+    return RecordedBudgets[connection];
+}
+
+// the server game play sends go here instead of a socket, we just count them
+void CountSends(void* user, const uint16_t* connections, size_t connectionCount, const uint8_t* data, size_t length)
+{
+    (void)connections;
+    (void)data;
+    (void)length;
+
+    ReplayStats* stats = (ReplayStats*)user;
+    stats->ReplayedSends += connectionCount;
+}
+
+// replay a server capture through the server game play, with as many NPCs as the server that made it had
+void ReplayServer(NetCaptureReader* reader, ReplayStats* stats, int npcs)
+{
+    NetServer* server = NetServerCreate(CountSends, stats, npcs);
+    NetServerSetBudget(server, RecordedBudget);
+
+    NetCaptureRecord record;
+    const uint8_t* data = NULL;
+
+    uint64_t start = NetCaptureClock();
+    while (NetCaptureReaderNext(reader, &record, &data))
+    {
+        NetMessage message = { data, record.Length };
+
+        switch (record.Direction)
+        {
+        // the server simulation ticks exactly when the live one did, with the same clock
+        case CaptureTick:
+            if (record.Length == sizeof(double))
+            {
+                double now;
+                memcpy(&now, data, sizeof(now));
+                NetServerUpdate(server, now);
+            }
+            continue;
+
+        // the budgets come before the tick that uses them
+        case CaptureBudget:
+            if (record.Length == sizeof(uint64_t))
+            {
+                uint64_t budget;
+                memcpy(&budget, data, sizeof(budget));
+                RecordedBudgets[record.Connection] = (size_t)budget;
+            }
+            continue;
+
+        case CaptureConnected:
+            NetServerConnect(server, record.Connection);
+            break;
+
+        case CaptureReceived:
+            NetServerHandleMessage(server, record.Connection, &message);
+            break;
+
+        case CaptureDisconnected:
+            NetServerDisconnect(server, record.Connection);
+            break;
+
+        case CaptureSent:
+            stats->RecordedSends++;
+            continue;
+        }
+        stats->Handled++;
+    }
+    stats->Nanoseconds += NetCaptureClock() - start;
+
+    stats->Hash = NetServerStateHash(server);
+    NetServerDestroy(server);
+}
+
+// replay a client capture through the client game play
+void ReplayClient(NetCaptureReader* reader, ReplayStats* stats)
+{
+    NetClient* client = NetClientCreate();
+
+    NetCaptureRecord record;
+    const uint8_t* data = NULL;
+
+    uint64_t start = NetCaptureClock();
+    while (NetCaptureReaderNext(reader, &record, &data))
+    {
+        NetMessage message = { data, record.Length };
+
+        // the client uses the time for extrapolation, so use the time from the capture
+        NetClientSetTime(client, record.Timestamp / 1000000000.0);
+
+        switch (record.Direction)
+        {
+        case CaptureConnected:
+            // every connection starts with a fresh local simulation
+            NetClientDestroy(client);
+            client = NetClientCreate();
+            break;
+
+        case CaptureReceived:
+            NetClientHandleMessage(client, &message);
+            break;
+
+        case CaptureDisconnected:
+            NetClientDisconnect(client);
+            break;
+
+        case CaptureSent:
+            stats->RecordedSends++;
+            continue;
+
+        // only the server records these
+        case CaptureTick:
+        case CaptureBudget:
+            continue;
+        }
+        stats->Handled++;
+    }
+    stats->Nanoseconds += NetCaptureClock() - start;
+
+    stats->Hash = NetClientStateHash(client);
+    NetClientDestroy(client);
+}
+
+// the messages in a capture, packed together the way enet would put them in datagrams
+typedef struct
+{
+    const uint8_t** Data;
+    size_t* Lengths;
+    size_t Count;
+
+    // storage for the packed datagrams
+    uint8_t* Buffer;
+}CaptureDatagrams;
+
+// messages going the same way on the same connection within a millisecond of each other went out in the same service pass,
+// so they are packed together, up to about what fits in a datagram
+#define PackTime 1000000
+#define PackLimit 1200
+
+void LoadDatagrams(NetCaptureReader* reader, CaptureDatagrams* datagrams)
+{
+    NetCaptureRecord record;
+    const uint8_t* data = NULL;
+
+    size_t total = 0;
+    size_t messages = 0;
+    NetCaptureReaderRewind(reader);
+    while (NetCaptureReaderNext(reader, &record, &data))
+    {
+        total += record.Length;
+        messages++;
+    }
+
+    datagrams->Data = (const uint8_t**)malloc(sizeof(uint8_t*) * (messages + 1));
+    datagrams->Lengths = (size_t*)calloc(messages + 1, sizeof(size_t));
+    datagrams->Buffer = (uint8_t*)malloc(total + 1);
+    datagrams->Count = 0;
+
+    // the datagram each message goes in
+    size_t* assigned = (size_t*)malloc(sizeof(size_t) * (messages + 1));
+
+    // the datagram still being packed for each connection and direction (+ 1 so 0 means none), and the time of its last message
+    size_t* open = (size_t*)calloc(65536 * 2, sizeof(size_t));
+    uint64_t* openTime = (uint64_t*)calloc(65536 * 2, sizeof(uint64_t));
+
+    // first pass works out the datagrams and how long they are
+    size_t message = 0;
+    NetCaptureReaderRewind(reader);
+    while (NetCaptureReaderNext(reader, &record, &data))
+    {
+        if (record.Length == 0 || (record.Direction != CaptureSent && record.Direction != CaptureReceived))
+        {
+            assigned[message++] = SIZE_MAX;
+            continue;
+        }
+
+        size_t slot = (size_t)record.Connection * 2 + record.Direction;
+        size_t index = open[slot];
+        if (index == 0 || record.Timestamp - openTime[slot] >= PackTime || datagrams->Lengths[index - 1] + record.Length > PackLimit)
+            index = ++datagrams->Count;
+
+        assigned[message++] = index - 1;
+        datagrams->Lengths[index - 1] += record.Length;
+        open[slot] = index;
+        openTime[slot] = record.Timestamp;
+    }
+
+    // lay the datagrams out one after another
+    size_t used = 0;
+    for (size_t i = 0; i < datagrams->Count; i++)
+    {
+        datagrams->Data[i] = datagrams->Buffer + used;
+        used += datagrams->Lengths[i];
+        datagrams->Lengths[i] = 0;
+    }
+
+    // second pass copies the messages in
+    message = 0;
+    NetCaptureReaderRewind(reader);
+    while (NetCaptureReaderNext(reader, &record, &data))
+    {
+        size_t index = assigned[message++];
+        if (index == SIZE_MAX)
+            continue;
+
+        memcpy((uint8_t*)datagrams->Data[index] + datagrams->Lengths[index], data, record.Length);
+        datagrams->Lengths[index] += record.Length;
+    }
+
+    free(assigned);
+    free(open);
+    free(openTime);
+}
+
+void FreeDatagrams(CaptureDatagrams* datagrams)
+{
+    free((void*)datagrams->Data);
+    free(datagrams->Lengths);
+    free(datagrams->Buffer);
+}
+
+// compress every datagram (the short ones are left as they are, like the host compressor does) and report the ratio and speed
+void ReportCompression(const char* name, const CaptureDatagrams* datagrams, const uint8_t* dictionary, size_t dictionaryLength)
+{
+    uint8_t compressed[PackLimit * 2];
+    uint8_t decompressed[PackLimit];
+
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    uint64_t compressedBytes = 0;
+    uint64_t compressNanoseconds = 0;
+    uint64_t decompressNanoseconds = 0;
+    uint64_t failed = 0;
+
+    NetCompressor* compressor = NetCompressorCreate(dictionary, dictionaryLength);
+
+    for (size_t i = 0; i < datagrams->Count; i++)
+    {
+        size_t length = datagrams->Lengths[i];
+        bytesIn += length;
+
+        if (length < NetCompressMinimumSize)
+        {
+            bytesOut += length;
+            continue;
+        }
+
+        uint64_t start = NetCaptureClock();
+        size_t compressedLength = NetCompressorCompress(compressor, datagrams->Data[i], length, compressed, sizeof(compressed));
+        compressNanoseconds += NetCaptureClock() - start;
+        compressedBytes += length;
+
+        start = NetCaptureClock();
+        size_t decompressedLength = NetCompressorDecompress(compressor, compressed, compressedLength, decompressed, sizeof(decompressed));
+        decompressNanoseconds += NetCaptureClock() - start;
+
+        // the codec must give back exactly what went in
+        if (decompressedLength != length || memcmp(decompressed, datagrams->Data[i], length) != 0)
+            failed++;
+
+        bytesOut += compressedLength > 0 && compressedLength < length ? compressedLength : length;
+    }
+
+    NetCompressorDestroy(compressor);
+
+    printf("compression %-18s %llu datagrams %llu bytes -> %llu bytes ratio %.3f, compress %.2f ns/byte decompress %.2f ns/byte%s\n",
+        name, (unsigned long long)datagrams->Count, (unsigned long long)bytesIn, (unsigned long long)bytesOut,
+        bytesOut > 0 ? (double)bytesIn / (double)bytesOut : 0.0,
+        compressedBytes > 0 ? (double)compressNanoseconds / (double)compressedBytes : 0.0,
+        compressedBytes > 0 ? (double)decompressNanoseconds / (double)compressedBytes : 0.0,
+        failed > 0 ? " (ROUND TRIP FAILED)" : "");
+}
+
+// write a dictionary out as the C source for netcore
+bool WriteDictionary(const char* fileName, const uint8_t* dictionary, size_t length)
+{
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL)
+        return false;
+
+    fprintf(file, "// the datagram compression dictionary for game traffic\n");
+    fprintf(file, "// generated by tools/replay --train from a capture, regenerate it when the messages change\n\n");
+    fprintf(file, "#include \"compress.h\"\n\n");
+    fprintf(file, "const uint8_t NetCompressGameDictionary[] =\n{");
+    for (size_t i = 0; i < length; i++)
+        fprintf(file, "%s0x%02x,", i % 16 == 0 ? "\n    " : " ", dictionary[i]);
+    fprintf(file, "\n};\n\n");
+    fprintf(file, "const size_t NetCompressGameDictionarySize = sizeof(NetCompressGameDictionary);\n");
+
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("usage: replay <capture file> [--client] [--iterations <count>] [--npcs <count>] [--compress] [--train <dictionary source file>]\n");
+        return 1;
+    }
+
+    bool client = false;
+    bool compress = false;
+    const char* train = NULL;
+    int iterations = 1;
+    int npcs = 0;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--client") == 0)
+            client = true;
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--npcs") == 0 && i + 1 < argc)
+            npcs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--compress") == 0)
+            compress = true;
+        else if (strcmp(argv[i], "--train") == 0 && i + 1 < argc)
+            train = argv[++i];
+    }
+
+    if (iterations < 1)
+        iterations = 1;
+
+    NetCaptureReader* reader = NetCaptureReaderOpen(argv[1]);
+    if (reader == NULL)
+    {
+        printf("Unable to read capture %s\n", argv[1]);
+        return 1;
+    }
+
+    ReplayStats stats = { 0 };
+    uint64_t lastHash = 0;
+    bool stable = true;
+
+    for (int i = 0; i < iterations; i++)
+    {
+        NetCaptureReaderRewind(reader);
+
+        if (client)
+            ReplayClient(reader, &stats);
+        else
+            ReplayServer(reader, &stats, npcs);
+
+        // the same capture must always give the same state
+        if (i > 0 && stats.Hash != lastHash)
+            stable = false;
+        lastHash = stats.Hash;
+    }
+
+    if (compress || train != NULL)
+    {
+        CaptureDatagrams datagrams;
+        LoadDatagrams(reader, &datagrams);
+
+        ReportCompression("no dictionary", &datagrams, NULL, 0);
+        ReportCompression("game dictionary", &datagrams, NetCompressGameDictionary, NetCompressGameDictionarySize);
+
+        if (train != NULL)
+        {
+            uint8_t dictionary[NetCompressMaxDictionarySize];
+            size_t length = NetCompressTrain(datagrams.Data, datagrams.Lengths, datagrams.Count, dictionary, sizeof(dictionary));
+            ReportCompression("trained dictionary", &datagrams, dictionary, length);
+
+            if (WriteDictionary(train, dictionary, length))
+                printf("wrote a %d byte dictionary to %s\n", (int)length, train);
+            else
+                printf("Unable to write %s\n", train);
+        }
+
+        FreeDatagrams(&datagrams);
+    }
+
+    NetCaptureReaderClose(reader);
+
+    printf("replayed %llu events %d times through the %s\n", (unsigned long long)(stats.Handled / iterations), iterations, client ? "client" : "server");
+    printf("sends recorded %llu replayed %llu\n", (unsigned long long)(stats.RecordedSends / iterations), (unsigned long long)(stats.ReplayedSends / iterations));
+    printf("%.1f ns/packet\n", stats.Handled > 0 ? (double)stats.Nanoseconds / (double)stats.Handled : 0.0);
+    printf("state hash %016llx%s\n", (unsigned long long)stats.Hash, stable ? "" : " (NOT STABLE between iterations)");
+
+    return stable ? 0 : 2;
+}